@@ -5,7 +5,7 @@ in VS_OUT {
     vec3 FragPos;
     vec3 Normal;
     vec2 TexCoords;
-    vec4 FragPosLightSpace;
+    vec4 Color;
 } fs_in;
 
 // Twoje istniejce:
@@ -20,19 +20,48 @@ uniform float texWorldSize;   // ile jednostek 
 
 
 
-// Nowe:
-uniform vec3 viewPos;
+// Dane klatki - wsplny bufor std140 (FrameUniforms.h), ten sam blok we wszystkich shaderach
+#define MAX_SHADOW_CASCADES 4
 
-// directional light (najprostsze i dobre do cieni)
-uniform vec3 lightDir;     // kierunek wiata (np. (-0.3, -1.0, -0.2))
-uniform vec3 lightColor;   // np. (1,1,1)
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 cascadeMatrices[MAX_SHADOW_CASCADES]; // wiat -> przestrze wiata kaskady
+    vec4 cascadeRects[MAX_SHADOW_CASCADES];    // miejsce kaskady w atlasie cieni (xy = pocztek, zw = rozmiar, w UV)
+    vec4 cascadeSplits;                        // dalsza granica kaskady (odlego od kamery)
+    vec3 viewPos;
+    int cascadeCount;
+    vec3 lightDir;     // kierunek padania wiata
+    vec3 lightColor;
+};
 
-// Cienie:
-uniform sampler2D shadowMap;
+// Cienie (atlas wszystkich kaskad, porwnanie gbi robi sprzt):
+uniform sampler2DShadow shadowMap;
+uniform int shadowFilter; // ShadowFilter z ShadowMap.h: 0 = sprztowy 2x2, 1 = Poisson, 2 = PCF 3x3
+
+const vec2 poissonDisk[8] = vec2[](
+    vec2(-0.613392, 0.617481), vec2(0.170019, -0.040254),
+    vec2(-0.299417, 0.791925), vec2(0.645680, 0.493210),
+    vec2(-0.651784, 0.717887), vec2(0.421003, 0.027070),
+    vec2(-0.817194, -0.271096), vec2(-0.705374, -0.668203)
+);
+
+// Pierwsza kaskada, ktrej zasig obejmuje fragment (-1 = dalej ni cienie)
+int CascadeIndex(vec3 fragPos)
+{
+    float depth = -(view * vec4(fragPos, 1.0)).z;
+    for (int i = 0; i < cascadeCount; ++i)
+        if (depth < cascadeSplits[i]) return i;
+    return -1;
+}
 
 // PCF + bias
-float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDirNorm)
+float ShadowCalculation(vec3 fragPos, vec3 normal, vec3 lightDirNorm)
 {
+    int cascade = CascadeIndex(fragPos);
+    if (cascade < 0) return 0.0;
+
+    vec4 fragPosLightSpace = cascadeMatrices[cascade] * vec4(fragPos, 1.0);
     vec3 projCoords = fragPosLightSpace.xyz / fragPosLightSpace.w;
     projCoords = projCoords * 0.5 + 0.5;
 
@@ -50,18 +79,46 @@ float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDirNorm)
     // bias (wane przeciw "shadow acne")
     float bias = max(0.003 * (1.0 - dot(normal, -lightDirNorm)), 0.0005);
 
-    // PCF 3x3
-    float shadow = 0.0;
+    // UV w atlasie; prbki PCF nie mog wyj na ssiedni kaskad
+    vec4 rect = cascadeRects[cascade];
     vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0));
-    for (int x = -1; x <= 1; ++x)
-    for (int y = -1; y <= 1; ++y)
+    vec2 uv = rect.xy + projCoords.xy * rect.zw;
+    vec2 uvMin = rect.xy + texelSize * 0.5;
+    vec2 uvMax = rect.xy + rect.zw - texelSize * 0.5;
+
+    // Kada prbka zwraca uamek owietlenia (sprzt porwnuje 4 ssiednie teksele i miesza)
+    float ref = currentDepth - bias;
+    float lit = 0.0;
+
+    if (shadowFilter == 0)
     {
-        float pcfDepth = texture(shadowMap, projCoords.xy + vec2(x, y) * texelSize).r;
-        shadow += (currentDepth - bias > pcfDepth) ? 1.0 : 0.0;
+        // Jedna prbka = sprztowe PCF 2x2
+        lit = texture(shadowMap, vec3(clamp(uv, uvMin, uvMax), ref));
+    }
+    else if (shadowFilter == 1)
+    {
+        // 8 prbek z dysku Poissona obrconego losowo dla kadego piksela (szum zamiast schodkw)
+        float angle = 6.2831853 * fract(sin(dot(gl_FragCoord.xy, vec2(12.9898, 78.233))) * 43758.5453);
+        mat2 rotation = mat2(cos(angle), sin(angle), -sin(angle), cos(angle));
+        for (int i = 0; i < 8; ++i)
+        {
+            vec2 offset = rotation * poissonDisk[i] * 1.5 * texelSize;
+            lit += texture(shadowMap, vec3(clamp(uv + offset, uvMin, uvMax), ref));
+        }
+        lit /= 8.0;
+    }
+    else
+    {
+        // PCF 3x3
+        for (int x = -1; x <= 1; ++x)
+        for (int y = -1; y <= 1; ++y)
+        {
+            lit += texture(shadowMap, vec3(clamp(uv + vec2(x, y) * texelSize, uvMin, uvMax), ref));
+        }
+        lit /= 9.0;
     }
-    shadow /= 9.0;
 
-    return shadow;
+    return 1.0 - lit;
 }
 
 void main()
@@ -99,7 +156,7 @@ void main()
     }
 
 
-    vec4 baseColor = texColor * objectColor;
+    vec4 baseColor = texColor * objectColor * fs_in.Color;
 
     // Jeli masz "cutout" (dziury)  odetnij piksele prawie przezroczyste
     // (dla np. rolin/siatek). Jeli nie uywasz, moesz to usun.
@@ -146,7 +203,7 @@ void main()
     float spec = pow(max(dot(V, R), 0.0), 32.0);
     vec3 specular = 0.5 * spec * lightColor;
 
-    float shadow = ShadowCalculation(fs_in.FragPosLightSpace, norm, L);
+    float shadow = ShadowCalculation(fs_in.FragPos, norm, L);
 
     // ambient bez cienia, reszta przyciemniana cieniem
     vec3 lighting = ambient + (1.0 - shadow) * (diffuse + specular);
@@ -1,10 +1,38 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
+layout (location = 3) in mat4 aInstanceModel;
+layout (location = 11) in vec3 aInstanceOffset; // RenderQueue::SubmitAt, poza tym 0
 
 uniform mat4 model;
-uniform mat4 lightSpaceMatrix;
+uniform int useInstancing;
+uniform int cascade; // ktra kaskada jest teraz rysowana
+
+// Macierze obiektw z RenderQueue (ten sam bufor co w zwykym przebiegu)
+uniform samplerBuffer transforms;
+uniform int transformIndex;
+
+// Dane klatki - wsplny bufor std140 (FrameUniforms.h), ten sam blok we wszystkich shaderach
+#define MAX_SHADOW_CASCADES 4
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 cascadeMatrices[MAX_SHADOW_CASCADES]; // wiat -> przestrze wiata kaskady
+    vec4 cascadeRects[MAX_SHADOW_CASCADES];    // miejsce kaskady w atlasie cieni (xy = pocztek, zw = rozmiar, w UV)
+    vec4 cascadeSplits;                        // dalsza granica kaskady (odlego od kamery)
+    vec3 viewPos;
+    int cascadeCount;
+    vec3 lightDir;     // kierunek padania wiata
+    vec3 lightColor;
+};
 
 void main()
 {
-    gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+    int base = transformIndex * 7;
+    mat4 M = (useInstancing == 1) ? aInstanceModel :
+             (transformIndex >= 0) ? mat4(texelFetch(transforms, base), texelFetch(transforms, base + 1),
+                                          texelFetch(transforms, base + 2), texelFetch(transforms, base + 3)) : model;
+    vec4 worldPos = M * vec4(aPos, 1.0);
+    worldPos.xyz += aInstanceOffset;
+    gl_Position = cascadeMatrices[cascade] * worldPos;
 }
@@ -3,8 +3,20 @@ layout (location = 0) in vec3 aPos;
 
 out vec3 TexCoords;
 
-uniform mat4 view;
-uniform mat4 projection;
+// Dane klatki - wsplny bufor std140 (FrameUniforms.h), ten sam blok we wszystkich shaderach
+#define MAX_SHADOW_CASCADES 4
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 cascadeMatrices[MAX_SHADOW_CASCADES]; // wiat -> przestrze wiata kaskady
+    vec4 cascadeRects[MAX_SHADOW_CASCADES];    // miejsce kaskady w atlasie cieni (xy = pocztek, zw = rozmiar, w UV)
+    vec4 cascadeSplits;                        // dalsza granica kaskady (odlego od kamery)
+    vec3 viewPos;
+    int cascadeCount;
+    vec3 lightDir;     // kierunek padania wiata
+    vec3 lightColor;
+};
 
 void main()
 {
@@ -4,33 +4,73 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
 
+// Rysowanie instancjonowane (useInstancing = 1): macierz i kolor z bufora instancji
+layout (location = 3) in mat4 aInstanceModel;
+layout (location = 7) in vec4 aInstanceColor;
+layout (location = 8) in mat3 aInstanceNormal;
+// Przesunicie kopii w wiecie (RenderQueue::SubmitAt); poza tym atrybut wyczony = 0
+layout (location = 11) in vec3 aInstanceOffset;
+
 out VS_OUT {
     vec3 FragPos;        // pozycja w wiecie
     vec3 Normal;         // normal w wiecie
     vec2 TexCoords;      // UV
-    vec4 FragPosLightSpace; // pod cienie
+    vec4 Color;          // kolor instancji (biay gdy bez instancji)
 } vs_out;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform int useInstancing;
+
+// Macierze obiektu policzone na CPU (RenderQueue): 4 teksele model + 3 teksele macierzy normalnych
+uniform samplerBuffer transforms;
+uniform int transformIndex; // -1 = uniform model (rysowania spoza kolejki)
+
+// Dane klatki - wsplny bufor std140 (FrameUniforms.h), ten sam blok we wszystkich shaderach
+#define MAX_SHADOW_CASCADES 4
 
-// Dla cieni (na razie moesz ustawi na macierz jednostkow, ale docelowo podasz z C++)
-uniform mat4 lightSpaceMatrix;
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 cascadeMatrices[MAX_SHADOW_CASCADES]; // wiat -> przestrze wiata kaskady
+    vec4 cascadeRects[MAX_SHADOW_CASCADES];    // miejsce kaskady w atlasie cieni (xy = pocztek, zw = rozmiar, w UV)
+    vec4 cascadeSplits;                        // dalsza granica kaskady (odlego od kamery)
+    vec3 viewPos;
+    int cascadeCount;
+    vec3 lightDir;     // kierunek padania wiata
+    vec3 lightColor;
+};
 
 void main()
 {
-    vec4 worldPos = model * vec4(aPos, 1.0);
+    mat4 M;
+    mat3 normalMatrix; // poprawia normalne przy skalowaniu w model matrix
+    if (useInstancing == 1)
+    {
+        M = aInstanceModel;
+        normalMatrix = aInstanceNormal;
+    }
+    else if (transformIndex >= 0)
+    {
+        int base = transformIndex * 7;
+        M = mat4(texelFetch(transforms, base), texelFetch(transforms, base + 1),
+                 texelFetch(transforms, base + 2), texelFetch(transforms, base + 3));
+        normalMatrix = mat3(texelFetch(transforms, base + 4).xyz, texelFetch(transforms, base + 5).xyz,
+                            texelFetch(transforms, base + 6).xyz);
+    }
+    else
+    {
+        // tylko nakadki i chmury - bez skalowania nierwnomiernego
+        M = model;
+        normalMatrix = mat3(model);
+    }
+    vec4 worldPos = M * vec4(aPos, 1.0);
+    worldPos.xyz += aInstanceOffset;
 
     vs_out.FragPos = worldPos.xyz;
-
-    // normal matrix poprawia normalne przy skalowaniu w model matrix
-    mat3 normalMatrix = transpose(inverse(mat3(model)));
     vs_out.Normal = normalize(normalMatrix * aNormal);
 
     vs_out.TexCoords = aTexCoords;
-
-    vs_out.FragPosLightSpace = lightSpaceMatrix * worldPos;
+    vs_out.Color = (useInstancing == 1) ? aInstanceColor : vec4(1.0);
 
     gl_Position = projection * view * worldPos;
 }
@@ -0,0 +1,76 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "MeshCache.h"
+#include "TextureManager.h"
+
+class Model;
+
+// Równoległe wczytywanie zasobów przy starcie gry.
+// Wątki robocze dekodują obrazy (stb_image) i importują modele (MeshCache / Assimp),
+// a wątek OpenGL w Finish tylko wysyła gotowe wyniki na GPU (tekstury przez PBO w TextureManager).
+// Tekstury materiałów modelu trafiają do kolejki zaraz po jego imporcie, więc czas startu
+// to mniej więcej najwolniejszy pojedynczy plik, a nie suma wszystkich.
+class AssetLoader {
+public:
+    // done / total zadań i nazwa pliku, który właśnie skończono (total rośnie, gdy import modelu dokłada tekstury)
+    using ProgressCallback = std::function<void(int done, int total, const std::string& name)>;
+
+    // threadCount = 0 -> liczba rdzeni - 1 (wątek GL też ma co robić)
+    explicit AssetLoader(int threadCount = 0);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // model musi żyć do końca Finish (Build jest wołane na wątku GL)
+    void QueueModel(Model& model, const std::string& path);
+    // Tekstura do TextureManager - późniejsze Load/Acquire tej ścieżki nie dekodują już pliku.
+    // Strumieniowane (stream = true przy włączonym strumieniowaniu) pomija - tekstury materiałów modeli też
+    void QueueTexture(const std::string& path, bool stream = true);
+    // Sam zdekodowany obraz dla własnych tekstur (np. ściany skyboxa); target musi żyć do końca Finish
+    void QueueImage(DecodedImage& target, const std::string& path, bool flipVertically);
+
+    // Na wątku GL: czeka na wyniki i wysyła je na GPU, aż wszystkie zadania się skończą.
+    // Modele są budowane na końcu, kiedy ich tekstury są już w TextureManager.
+    void Finish(const ProgressCallback& progress = ProgressCallback());
+
+private:
+    enum ResultKind { RESULT_TEXTURE, RESULT_IMAGE, RESULT_MODEL };
+
+    struct Result {
+        ResultKind kind;
+        std::string path;
+        DecodedImage image;
+        DecodedImage* imageTarget = nullptr;
+        Model* model = nullptr;
+        std::vector<MeshData> meshes;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::vector<Result> results;         // gotowe, czekają na wątek GL
+    std::unordered_set<uint64_t> queuedTextures; // hash ścieżki (AssetPath::Hash)
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable resultReady;
+    int pending = 0; // zadania w kolejce + w trakcie
+    int total = 0;
+    bool stopping = false;
+
+    void push(std::function<void()> job);
+    void queueTextureLocked(const std::string& path, bool stream);
+    void complete(Result&& result);
+    void workerLoop();
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "MappedFile.h"
+
+// Paczka zasobów (plik ".pak" z narzędzia wspinaczka_pack) - wszystkie pliki z assets/ w jednym pliku
+// mapowanym do pamięci. Układ: nagłówek, dane plików (każdy od granicy strony, więc widok na plik
+// zaczyna się na początku strony), tablica haszująca nazw (adresowanie otwarte, rozmiar = potęga 2)
+// i same nazwy. Nazwy są znormalizowane i haszowane jak klucze tekstur (AssetPath), więc wielkość
+// liter i rodzaj ukośników nie mają znaczenia - tak jak przy luźnych plikach na Windows.
+class AssetPack {
+public:
+    // Zmienić przy każdej zmianie układu pliku
+    static const uint32_t VERSION = 1;
+    static const size_t ALIGNMENT = 4096;
+
+    AssetPack() {}
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // false gdy pliku nie ma albo jest uszkodzony (błąd wypisywany tylko dla uszkodzonych)
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return file.IsOpen(); }
+    uint32_t FileCount() const { return fileCount; }
+
+    // Zawartość pliku wprost z mapowania (ważna do Close); nullptr gdy paczka go nie ma
+    const unsigned char* Find(const std::string& path, size_t& size) const;
+
+    // Zapis paczki: pary (nazwa w paczce, plik na dysku), dane w podanej kolejności; false przy błędzie (wypisany)
+    static bool Write(const std::string& packPath, const std::vector<std::pair<std::string, std::string>>& files);
+
+private:
+    MappedFile file;
+    const unsigned char* slots = nullptr;
+    const char* names = nullptr;
+    uint32_t slotCount = 0;
+    uint32_t fileCount = 0;
+};
+
+#endif
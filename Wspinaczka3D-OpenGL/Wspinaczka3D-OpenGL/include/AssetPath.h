@@ -0,0 +1,33 @@
+#ifndef ASSET_PATH_H
+#define ASSET_PATH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// FNV-1a 64 - jeden hasz dla całej gry (klucze tekstur, nazwy w paczce, cache siatek, uniformy).
+// seed = wynik dla poprzednich danych, gdy klucz składa się z kilku kawałków
+const uint64_t FNV1A_SEED = 14695981039346656037ull;
+
+inline uint64_t Fnv1a(const void* data, size_t size, uint64_t seed = FNV1A_SEED) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Ścieżki plików zasobów - wspólne dla TextureManager i paczki zasobów (AssetPack).
+// Gra chodzi na Windows, więc wielkość liter nie ma znaczenia przy porównywaniu ani haszu.
+namespace AssetPath {
+    // "assets\\models/./../models/a.png" -> "assets/models/a.png" (wielkość liter bez zmian)
+    std::string Normalize(const std::string& path);
+    // Fnv1a znormalizowanej ścieżki bez rozróżniania wielkości liter
+    uint64_t Hash(const std::string& normalizedPath);
+    // Porównanie bez rozróżniania wielkości liter (ASCII)
+    bool Equal(const char* a, const char* b, size_t length);
+}
+
+#endif
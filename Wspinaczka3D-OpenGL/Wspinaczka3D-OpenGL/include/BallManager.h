@@ -3,8 +3,9 @@
 
 #include <vector>
 #include <glm/glm.hpp>
-#include "Model.h"
-#include "Shader.h"
+
+class RenderQueue;
+class Model;
 
 struct RollingBall {
     glm::vec3 position;
@@ -17,7 +18,6 @@ struct RollingBall {
 class BallManager {
 public:
     std::vector<RollingBall> balls;
-    Model* ballModel;
 
     // Ustawienia
     float spawnTimer;
@@ -35,11 +35,11 @@ public:
     float maxZ;
 
     // Konstruktor
-    BallManager(Model* modelRef);
+    BallManager();
 
     // Metody gwne
     void Update(float deltaTime);
-    void Draw(Shader& shader);
+    void Submit(RenderQueue& queue, Model& ballModel);
     bool CheckCollision(glm::vec3 playerPos);
 
 private:
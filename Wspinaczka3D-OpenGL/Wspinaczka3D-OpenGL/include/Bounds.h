@@ -0,0 +1,106 @@
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <glm/glm.hpp>
+#include <cfloat>
+#include <algorithm>
+
+// Prostopadłościan wyrównany do osi. Domyślny jest pusty (Valid() == false).
+struct AABB {
+    glm::vec3 min = glm::vec3(FLT_MAX);
+    glm::vec3 max = glm::vec3(-FLT_MAX);
+
+    AABB() {}
+    AABB(const glm::vec3& mn, const glm::vec3& mx) : min(mn), max(mx) {}
+
+    bool Valid() const { return min.x <= max.x; }
+    glm::vec3 Center() const { return (min + max) * 0.5f; }
+    glm::vec3 HalfSize() const { return (max - min) * 0.5f; }
+
+    void Expand(const glm::vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+
+    void Expand(const AABB& other) {
+        if (!other.Valid()) return;
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+
+    // Pudełko obejmujące przekształcone pudełko (środek + |M| * połowa rozmiaru)
+    AABB Transformed(const glm::mat4& m) const {
+        if (!Valid()) return *this;
+        glm::vec3 c = glm::vec3(m * glm::vec4(Center(), 1.0f));
+        glm::vec3 h = HalfSize();
+        glm::vec3 e;
+        for (int i = 0; i < 3; i++) {
+            e[i] = std::abs(m[0][i]) * h.x + std::abs(m[1][i]) * h.y + std::abs(m[2][i]) * h.z;
+        }
+        return AABB(c - e, c + e);
+    }
+};
+
+struct BoundingSphere {
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = -1.0f; // < 0 = brak
+
+    bool Valid() const { return radius >= 0.0f; }
+
+    BoundingSphere Transformed(const glm::mat4& m) const {
+        if (!Valid()) return *this;
+        float scale = std::max(glm::length(glm::vec3(m[0])),
+            std::max(glm::length(glm::vec3(m[1])), glm::length(glm::vec3(m[2]))));
+        BoundingSphere s;
+        s.center = glm::vec3(m * glm::vec4(center, 1.0f));
+        s.radius = radius * scale;
+        return s;
+    }
+};
+
+// Sześć płaszczyzn wyciętych z macierzy projection * view (normalne do środka).
+// Domyślny (zerowe płaszczyzny) przepuszcza wszystko.
+struct Frustum {
+    glm::vec4 planes[6] = {};
+
+    static Frustum FromMatrix(const glm::mat4& m) {
+        Frustum f;
+        glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+        f.planes[0] = row3 + row0; // lewa
+        f.planes[1] = row3 - row0; // prawa
+        f.planes[2] = row3 + row1; // dół
+        f.planes[3] = row3 - row1; // góra
+        f.planes[4] = row3 + row2; // bliska
+        f.planes[5] = row3 - row2; // daleka
+        for (glm::vec4& p : f.planes) {
+            float len = glm::length(glm::vec3(p));
+            if (len > 0.0f) p /= len;
+        }
+        return f;
+    }
+
+    bool Intersects(const BoundingSphere& s) const {
+        if (!s.Valid()) return true;
+        for (const glm::vec4& p : planes) {
+            if (glm::dot(glm::vec3(p), s.center) + p.w < -s.radius) return false;
+        }
+        return true;
+    }
+
+    // Test wierzchołka najdalej w stronę normalnej - jeśli i on jest na zewnątrz, całe pudełko też
+    bool Intersects(const AABB& b) const {
+        if (!b.Valid()) return true;
+        for (const glm::vec4& p : planes) {
+            glm::vec3 v(p.x > 0.0f ? b.max.x : b.min.x,
+                p.y > 0.0f ? b.max.y : b.min.y,
+                p.z > 0.0f ? b.max.z : b.min.z);
+            if (glm::dot(glm::vec3(p), v) + p.w < 0.0f) return false;
+        }
+        return true;
+    }
+};
+
+#endif
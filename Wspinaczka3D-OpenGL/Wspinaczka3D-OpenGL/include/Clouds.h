@@ -97,13 +97,15 @@ public:
         shader.setInt("useTexture", 0);
         shader.setVec4("objectColor", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 
+        UniformHandle modelLoc = shader.uniform("model");
+        shader.setInt("transformIndex", -1); // macierz z uniformu, nie z bufora kolejki
         for (const auto& cloud : clouds) {
             for (const auto& component : cloud.components) {
                 glm::mat4 model = glm::mat4(1.0f);
                 model = glm::translate(model, cloud.position);
                 model = glm::translate(model, component.offset);
                 model = glm::scale(model, glm::vec3(component.scale));
-                shader.setMat4("model", model);
+                shader.set(modelLoc, model);
                 glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
             }
         }
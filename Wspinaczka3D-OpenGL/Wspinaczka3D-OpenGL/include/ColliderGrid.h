@@ -0,0 +1,70 @@
+#ifndef COLLIDER_GRID_H
+#define COLLIDER_GRID_H
+
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include "Hitbox.h"
+
+// Jeden obiekt, na którym można stanąć albo w który można uderzyć bokiem
+struct Collider {
+    enum Shape { BOX, RAMP_X }; // RAMP_X - wysokość rośnie liniowo wzdłuż osi X (rampa)
+    Shape shape = BOX;
+    TableHitbox box{};                 // obrys XZ, dla BOX topY to górna powierzchnia
+    float startY = 0.0f, endY = 0.0f;  // RAMP_X: wysokość na minX i na maxX
+
+    // Lądowanie: środek jajka w poprzednim kroku >= spoczynek - landFrom,
+    // teraz <= spoczynek + landTo (spoczynek = powierzchnia + połowa wysokości jajka)
+    bool landable = true;
+    float landFrom = 0.2f;
+    float landTo = 0.1f;
+    bool fallDamage = false;    // lądowanie liczy obrażenia od upadku
+
+    bool solidSides = false;    // blokuje ruch w poziomie
+    float sidesAboveY = -1e9f;  // ...ale tylko gdy jajko jest wyżej niż to
+
+    int platform = -1;          // indeks ruchomej platformy (przenosi gracza)
+
+    float SurfaceY(float x) const {
+        if (shape == BOX) return box.topY;
+        float t = glm::clamp((x - box.minX) / (box.maxX - box.minX), 0.0f, 1.0f);
+        return startY + (endY - startY) * t;
+    }
+};
+
+// Rejestr kolizji w jednolitej siatce XZ - zapytania sprawdzają tylko komórkę z jajkiem,
+// więc koszt nie rośnie z liczbą platform na torze
+class ColliderGrid {
+public:
+    explicit ColliderGrid(float cellSize = 4.0f) : cellSize(cellSize) {}
+
+    int Add(const Collider& c);
+    void MoveBox(int id, const TableHitbox& box); // dla ruchomych platform
+    const Collider& Get(int id) const { return colliders[id]; }
+    size_t Count() const { return colliders.size(); }
+
+    // Cofa ruch w XZ, jeśli jajko weszło bokiem w obiekt. Zwraca true przy kolizji.
+    bool ResolveHorizontal(glm::vec3& pos, const glm::vec3& oldPos, float halfHeight) const;
+
+    // Najwyższa powierzchnia, na której jajko właśnie ląduje (nullptr = brak).
+    // restY - wysokość środka jajka po wylądowaniu.
+    const Collider* FindSupport(const glm::vec3& pos, float oldY, float velocityY,
+        float halfHeight, float& restY) const;
+
+private:
+    struct CellRange { int x0, x1, z0, z1; };
+
+    float cellSize;
+    std::vector<Collider> colliders;
+    std::vector<CellRange> ranges;
+    std::unordered_map<long long, std::vector<int>> cells;
+
+    int Cell(float v) const;
+    static long long Key(int cx, int cz);
+    CellRange RangeOf(const TableHitbox& b) const;
+    void Insert(int id, const CellRange& r);
+    void Remove(int id, const CellRange& r);
+    const std::vector<int>* CellAt(const glm::vec3& pos) const;
+};
+
+#endif
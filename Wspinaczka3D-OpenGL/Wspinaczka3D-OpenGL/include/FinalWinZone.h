@@ -2,9 +2,11 @@
 #define FINAL_WIN_ZONE_H
 
 #include <glm/glm.hpp>
-#include "Model.h"
-#include "Shader.h"
-#include "UIManager.h"
+#include "Hitbox.h"
+
+class RenderQueue;
+class Model;
+class UIManager;
 
 class FinalWinZone {
 public:
@@ -53,19 +55,7 @@ public:
             pos.y >= topY - 2.0f; 
     }
 
-    void Draw(Shader& shader, Model& platformModel) {
-        shader.setInt("useTexture", 1);
-        shader.setVec4("objectColor", glm::vec4(0.0f, 1.0f, 0.0f, 1.0f)); // Zielona
-
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(position.x, topY - 0.2f, position.z));
-        model = glm::scale(model, glm::vec3(width, 0.4f, height));
-
-        shader.setMat4("model", model);
-        platformModel.Draw(shader);
-
-        shader.setVec4("objectColor", glm::vec4(1.0f));
-    }
+    void Submit(RenderQueue& queue, Model& platformModel);
 
     void DisplayWinMessage(UIManager* ui) {
         
@@ -0,0 +1,35 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+#include <cmath>
+
+// Akumulator czasu: fizyka zawsze liczona krokami o stałej długości,
+// niezależnie od FPS. Reszta czasu (Alpha) służy do interpolacji przy rysowaniu.
+class FixedTimestep {
+public:
+    float step;           // długość kroku symulacji [s]
+    int maxStepsPerFrame; // przy dużym przycięciu gubimy czas zamiast liczyć w nieskończoność
+    float accumulator = 0.0f;
+
+    FixedTimestep(float stepSeconds = 1.0f / 120.0f, int maxSteps = 8)
+        : step(stepSeconds), maxStepsPerFrame(maxSteps) {}
+
+    // Dodaje czas klatki, zwraca ile kroków trzeba teraz policzyć
+    int Advance(float frameTime) {
+        if (frameTime < 0.0f) frameTime = 0.0f;
+        accumulator += frameTime;
+
+        int steps = (int)std::floor(accumulator / step);
+        if (steps > maxStepsPerFrame) {
+            steps = maxStepsPerFrame;
+            accumulator = step * steps;
+        }
+        accumulator -= step * steps;
+        return steps;
+    }
+
+    // 0..1 - jak daleko jesteśmy między ostatnim a następnym krokiem
+    float Alpha() const { return accumulator / step; }
+};
+
+#endif
@@ -3,7 +3,8 @@
 
 #include <glm/glm.hpp>
 #include "Model.h"
-#include "Shader.h"
+
+class RenderQueue;
 
 class FlyoverBridge {
 public:
@@ -16,7 +17,7 @@ public:
     FlyoverBridge(glm::vec3 pos, glm::vec3 rot, glm::vec3 sc, Model* modelRef);
 
     // Metoda
-    void Draw(Shader& shader);
+    void Submit(RenderQueue& queue);
 };
 
 #endif
\ No newline at end of file
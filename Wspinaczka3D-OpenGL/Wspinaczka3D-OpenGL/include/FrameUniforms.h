@@ -0,0 +1,50 @@
+#ifndef FRAME_UNIFORMS_H
+#define FRAME_UNIFORMS_H
+
+#include <glm/glm.hpp>
+
+// Tyle samo co MAX_SHADOW_CASCADES w shaderach
+const int MAX_SHADOW_CASCADES = 4;
+
+// Układ std140 bloku FrameData z shaderów (vec3 zajmuje 16 bajtów, stąd wypełnienia)
+struct FrameData {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 cascadeMatrices[MAX_SHADOW_CASCADES];
+    glm::vec4 cascadeRects[MAX_SHADOW_CASCADES];
+    glm::vec4 cascadeSplits;
+    glm::vec3 viewPos;    int cascadeCount;
+    glm::vec3 lightDir;   float pad1;
+    glm::vec3 lightColor; float pad2;
+};
+
+static_assert(sizeof(FrameData) == 512, "FrameData musi zgadzac sie z ukladem std140");
+
+// Jeden bufor UBO z danymi klatki dla wszystkich programów.
+// Każdy widok (kamera, ekran) ma swój wycinek - przełączamy glBindBufferRange, bez ponownego wysyłania.
+class FrameUniforms {
+public:
+    // Punkt wiązania bloku FrameData - Shader podpina go sam przy linkowaniu
+    static const unsigned int BINDING = 0;
+
+    enum View { VIEW_CAMERA, VIEW_SCREEN, VIEW_COUNT };
+
+    unsigned int UBO = 0;
+
+    FrameUniforms() {}
+
+    FrameUniforms(const FrameUniforms&) = delete;
+    FrameUniforms& operator=(const FrameUniforms&) = delete;
+
+    void Upload(View view, const FrameData& data);
+    void Bind(View view) const;
+
+    void Release();
+
+private:
+    long long stride = 0; // rozmiar wycinka zaokrąglony do GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+
+    void create();
+};
+
+#endif
@@ -3,8 +3,9 @@
 
 #include <glm/glm.hpp>
 #include <vector>
-#include "Shader.h"
-#include "Model.h"
+
+class RenderQueue;
+class Model;
 
 struct GlassTile {
     glm::vec3 position;
@@ -21,13 +22,12 @@ class GlassBridge {
 public:
     std::vector<GlassTile> tiles;
     float yLevel;
-    Model* tileModel;
 
     // Konstruktor
-    GlassBridge(glm::vec3 startPos, float height, Model* modelRef);
+    GlassBridge(glm::vec3 startPos, float height);
 
     // Metody
-    void Draw(Shader& shader);
+    void Submit(RenderQueue& queue, Model& tileModel);
     bool checkCollision(glm::vec3 playerPos, float& playerY, float& velocityY, float playerHalfHeight);
     void Reset();
 
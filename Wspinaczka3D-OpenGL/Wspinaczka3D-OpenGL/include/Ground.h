@@ -3,8 +3,9 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <string>
+#include "TextureManager.h"
 
-#include "Shader.h"
+class RenderQueue;
 
 class Ground {
 public:
@@ -12,14 +13,12 @@ public:
     // tiling = ile razy tekstura ma si powtrzy na caym plane
     Ground(const std::string& texturePath, float size = 120.0f, float tiling = 40.0f, float y = -0.01f);
 
-    void Draw(Shader& shader);
+    void Submit(RenderQueue& queue);
 
 private:
     unsigned int VAO = 0, VBO = 0;
-    unsigned int textureID = 0;
+    TextureHandle texture;
     float size = 120.0f;
     float tiling = 40.0f;
     float y = -0.01f;
-
-    unsigned int loadTexture2D(const std::string& path);
 };
@@ -0,0 +1,19 @@
+#ifndef HITBOX_H
+#define HITBOX_H
+
+// Hitboxy wspólne dla fizyki i obiektów świata (bez zależności od OpenGL)
+
+struct TableHitbox {
+    float minX, maxX;
+    float minZ, maxZ;
+    float topY;
+};
+
+struct RampHitbox {
+    float minX, maxX;
+    float minZ, maxZ;
+    float startY, endY;
+    float lengthZ;
+};
+
+#endif
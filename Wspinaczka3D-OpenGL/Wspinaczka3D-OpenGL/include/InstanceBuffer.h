@@ -0,0 +1,66 @@
+#ifndef INSTANCE_BUFFER_H
+#define INSTANCE_BUFFER_H
+
+#include <glm/glm.hpp>
+#include <cmath>
+
+// Macierz do normalnych (odwrotna transponowana 3x3) - liczona na CPU raz na obiekt, nie w shaderze
+inline glm::mat3 NormalMatrix(const glm::mat4& model) {
+    glm::mat3 m(model);
+    if (std::abs(glm::determinant(m)) < 1e-12f) return glm::mat3(0.0f); // zapadnięty obiekt - i tak niewidoczny
+    return glm::transpose(glm::inverse(m));
+}
+
+// Dane jednej instancji w buforze (atrybuty 3-6: macierz model, 7: kolor, 8-10: macierz normalnych)
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 color;
+    glm::mat3 normalMatrix;
+
+    InstanceData() {}
+    InstanceData(const glm::mat4& m, const glm::vec4& c) : model(m), color(c), normalMatrix(NormalMatrix(m)) {}
+
+    void SetModel(const glm::mat4& m) {
+        model = m;
+        normalMatrix = NormalMatrix(m);
+    }
+};
+
+// Bufor instancji na GPU do Mesh::DrawInstanced (wymaga kontekstu OpenGL).
+// Jak VAO w Mesh - znika razem z kontekstem; Release() gdy właściciel ginie wcześniej.
+class InstanceBuffer {
+public:
+    unsigned int VBO = 0;
+    int capacity = 0;
+
+    InstanceBuffer() {}
+
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    // Całość od nowa (bufor rośnie w razie potrzeby)
+    void Upload(const InstanceData* data, int count);
+
+    // Tylko zmieniony fragment - bufor musi już mieć co najmniej first + count miejsc
+    void UploadRange(const InstanceData* data, int first, int count);
+
+    void Release();
+};
+
+// Same pozycje kopii (atrybut 11) - dla wielu kopii o wspólnej macierzy i kolorze (cząsteczki).
+// 12 bajtów na kopię zamiast całego InstanceData; macierz idzie jak przy zwykłym Submit.
+class PositionBuffer {
+public:
+    unsigned int VBO = 0;
+    int capacity = 0;
+
+    PositionBuffer() {}
+
+    PositionBuffer(const PositionBuffer&) = delete;
+    PositionBuffer& operator=(const PositionBuffer&) = delete;
+
+    void Upload(const glm::vec3* data, int count);
+    void Release();
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef MATERIAL_H
+#define MATERIAL_H
+
+class Shader;
+
+// Rodzaje map materiału. Każdy slot ma stałą jednostkę tekstury i nazwę samplera,
+// więc przy rysowaniu nie trzeba już ustawiać uniformów - tylko podpiąć tekstury.
+enum TextureSlot {
+    TEXTURE_DIFFUSE = 0,
+    TEXTURE_METALNESS,
+    TEXTURE_ROUGHNESS,
+    TEXTURE_NORMAL,
+    TEXTURE_SLOT_COUNT
+};
+
+struct Material {
+    unsigned int textures[TEXTURE_SLOT_COUNT] = {}; // id tekstury GL na slot (0 = brak)
+
+    unsigned int Diffuse() const { return textures[TEXTURE_DIFFUSE]; }
+    bool operator==(const Material& other) const;
+    bool operator<(const Material& other) const; // klucz w mapach (StaticBatch)
+
+    // Podpina tylko sloty, które program próbkuje (maska z ResolveSamplers)
+    void Bind(unsigned int slotMask) const;
+
+    // Jednostka tekstury slotu (3 jest zajęta przez shadowMap)
+    static int Unit(TextureSlot slot);
+    static const char* SamplerName(TextureSlot slot);
+
+    // Raz po linkowaniu: ustawia samplery aktywne w programie na jednostki slotów,
+    // zwraca maskę slotów (bit = 1 << slot), których program używa
+    static unsigned int ResolveSamplers(Shader& shader);
+};
+
+#endif
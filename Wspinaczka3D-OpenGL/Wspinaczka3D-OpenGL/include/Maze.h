@@ -2,18 +2,23 @@
 #define MAZE_H
 
 #include <vector>
+#include <string>
+#include <cstdint>
+#include <cmath>
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include "Shader.h"
-#include "Mesh.h"
-#include <iostream>
+#include "MazeGrid.h"
+
+class RenderQueue;
+class Mesh;
 
 class Maze {
 public:
-    struct Wall {
-        float x, z;
-        float width;
+    // Prostokt ssiednich pl ze cian (w polach siatki) - wynik MergeWalls
+    struct WallBox {
+        int col, row;
+        int width, depth;
     };
+    // Z TextureManager (Acquire) - yj do koca gry, zwalnia je TextureManager::Shutdown
     unsigned int wallTextureID = 0;
     unsigned int floorTextureID = 0;
     Mesh* floorMesh = nullptr;
@@ -22,11 +27,16 @@ public:
     Mesh* floorSlabMesh = nullptr;
 
 
-    unsigned int loadTexture2D(const std::string& path);
+    float wallHeight = 5.0f;
+    Mesh* wallMesh = nullptr; // wszystkie ciany upieczone w jedn siatk (MazeDraw.cpp)
+
+    // Mapa zajtoci: bit na pole, wiersz po wierszu (cols x rows)
+    int cols = 0;
+    int rows = 0;
+    std::vector<uint64_t> occupancy;
 
-    std::vector<Wall> walls;
     glm::vec3 startPosition;
-    Mesh* cubeMesh;
+    Mesh* cubeMesh = nullptr;
     float blockSize;
     float mazeWidth;  // Szeroko caego labiryntu
     float mazeDepth;  // Gboko caego labiryntu
@@ -35,136 +45,8 @@ public:
         startPosition = pos;
         blockSize = 2.0f; // Rozmiar bloku 2x2
 
-        // Labirynt ma 10x10 pl
-        mazeWidth = 10 * blockSize;
-        mazeDepth = 10 * blockSize;
-
-        // 1. TWORZENIE GEOMETRII SZECIANU
-        std::vector<Vertex> vertices = {
-            // Ty
-            {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f}},
-            {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f}},
-            {{ 0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {1.0f, 1.0f}},
-            {{ 0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {1.0f, 1.0f}},
-            {{-0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f}},
-            {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f}},
-            // Przd
-            {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
-            {{ 0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},
-            {{ 0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
-            {{ 0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
-            {{-0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},
-            {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
-            // Lewo
-            {{-0.5f,  0.5f,  0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
-            {{-0.5f,  0.5f, -0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
-            {{-0.5f, -0.5f, -0.5f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
-            {{-0.5f, -0.5f, -0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
-            {{-0.5f, -0.5f,  0.5f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
-            {{-0.5f,  0.5f,  0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
-            // Prawo
-            {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
-            {{ 0.5f,  0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
-            {{ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
-            {{ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
-            {{ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
-            {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
-            // D
-            {{-0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 1.0f}},
-            {{ 0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 1.0f}},
-            {{ 0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
-            {{ 0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
-            {{-0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
-            {{-0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 1.0f}},
-            // Gra
-            {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}},
-            {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}},
-            {{ 0.5f,  0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
-            {{ 0.5f,  0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
-            {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
-            {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}}
-        };
-
-        std::vector<unsigned int> indices;
-        for (unsigned int i = 0; i < vertices.size(); i++) indices.push_back(i);
-        std::vector<Texture> textures;
-        cubeMesh = new Mesh(vertices, indices, textures);
-
-        // --- TEXTURy 
-        wallTextureID = loadTexture2D("assets/textures/maze_wall.png");   // np. cega/kamie
-        floorTextureID = loadTexture2D("assets/textures/maze_floor.png");  // np. pytki/kamie
-
-        // --- FLOOR MESH 
-        float halfW = mazeWidth * 0.5f;
-        float halfD = mazeDepth * 0.5f;
-
-        float topY = 0.0f;
-        float botY = -floorThickness;
-
-        float tileTop = 10.0f;   // tiling na grze
-        float tileSide = 2.0f;   // tiling na bokach 
-
-        std::vector<Vertex> v;
-
-        // --- TOP (normal up) ---
-        v.push_back({ {-halfW, topY, -halfD}, {0,1,0}, {0,0} });
-        v.push_back({ { halfW, topY, -halfD}, {0,1,0}, {tileTop,0} });
-        v.push_back({ { halfW, topY,  halfD}, {0,1,0}, {tileTop,tileTop} });
-        v.push_back({ { halfW, topY,  halfD}, {0,1,0}, {tileTop,tileTop} });
-        v.push_back({ {-halfW, topY,  halfD}, {0,1,0}, {0,tileTop} });
-        v.push_back({ {-halfW, topY, -halfD}, {0,1,0}, {0,0} });
-
-        // --- BOTTOM (normal down) ---
-        v.push_back({ {-halfW, botY,  halfD}, {0,-1,0}, {0,0} });
-        v.push_back({ { halfW, botY,  halfD}, {0,-1,0}, {tileTop,0} });
-        v.push_back({ { halfW, botY, -halfD}, {0,-1,0}, {tileTop,tileTop} });
-        v.push_back({ { halfW, botY, -halfD}, {0,-1,0}, {tileTop,tileTop} });
-        v.push_back({ {-halfW, botY, -halfD}, {0,-1,0}, {0,tileTop} });
-        v.push_back({ {-halfW, botY,  halfD}, {0,-1,0}, {0,0} });
-
-        // --- SIDE +Z (front) normal (0,0,1) ---
-        v.push_back({ {-halfW, botY,  halfD}, {0,0,1}, {0,0} });
-        v.push_back({ { halfW, botY,  halfD}, {0,0,1}, {tileSide,0} });
-        v.push_back({ { halfW, topY,  halfD}, {0,0,1}, {tileSide,1} });
-        v.push_back({ { halfW, topY,  halfD}, {0,0,1}, {tileSide,1} });
-        v.push_back({ {-halfW, topY,  halfD}, {0,0,1}, {0,1} });
-        v.push_back({ {-halfW, botY,  halfD}, {0,0,1}, {0,0} });
-
-        // --- SIDE -Z (back) normal (0,0,-1) ---
-        v.push_back({ { halfW, botY, -halfD}, {0,0,-1}, {0,0} });
-        v.push_back({ {-halfW, botY, -halfD}, {0,0,-1}, {tileSide,0} });
-        v.push_back({ {-halfW, topY, -halfD}, {0,0,-1}, {tileSide,1} });
-        v.push_back({ {-halfW, topY, -halfD}, {0,0,-1}, {tileSide,1} });
-        v.push_back({ { halfW, topY, -halfD}, {0,0,-1}, {0,1} });
-        v.push_back({ { halfW, botY, -halfD}, {0,0,-1}, {0,0} });
-
-        // --- SIDE +X (right) normal (1,0,0) ---
-        v.push_back({ { halfW, botY,  halfD}, {1,0,0}, {0,0} });
-        v.push_back({ { halfW, botY, -halfD}, {1,0,0}, {tileSide,0} });
-        v.push_back({ { halfW, topY, -halfD}, {1,0,0}, {tileSide,1} });
-        v.push_back({ { halfW, topY, -halfD}, {1,0,0}, {tileSide,1} });
-        v.push_back({ { halfW, topY,  halfD}, {1,0,0}, {0,1} });
-        v.push_back({ { halfW, botY,  halfD}, {1,0,0}, {0,0} });
-
-        // --- SIDE -X (left) normal (-1,0,0) ---
-        v.push_back({ {-halfW, botY, -halfD}, {-1,0,0}, {0,0} });
-        v.push_back({ {-halfW, botY,  halfD}, {-1,0,0}, {tileSide,0} });
-        v.push_back({ {-halfW, topY,  halfD}, {-1,0,0}, {tileSide,1} });
-        v.push_back({ {-halfW, topY,  halfD}, {-1,0,0}, {tileSide,1} });
-        v.push_back({ {-halfW, topY, -halfD}, {-1,0,0}, {0,1} });
-        v.push_back({ {-halfW, botY, -halfD}, {-1,0,0}, {0,0} });
-
-        std::vector<unsigned int> idx;
-        idx.reserve(v.size());
-        for (unsigned int i = 0; i < v.size(); i++) idx.push_back(i);
-
-        std::vector<Texture> noTex;
-        floorSlabMesh = new Mesh(v, idx, noTex);
-
-
-
-        // 2. MAPA LABIRYNTU
-        const char* mapLayout[10] = {
+        // MAPA LABIRYNTU (zamieniana na bity przy kompilacji)
+        constexpr MazeGrid<10, 10> layout = ParseMazeLayout<10, 10>({
             "bbbbbbbb b",
             "b   rrrr b",
             "b     rr b",
@@ -175,66 +57,61 @@ public:
             "br rrrrrrb",
             "br       b",
             "bbbbbb bbb"
-        };
-
-        for (int row = 0; row < 10; ++row) {
-            for (int col = 0; col < 10; ++col) {
-                if (mapLayout[row][col] != ' ') {
-                    Wall w;
-                    w.x = startPosition.x + (col * blockSize);
-                    w.z = startPosition.z + (row * blockSize);
-                    w.width = blockSize;
-                    walls.push_back(w);
-                }
-            }
-        }
+        });
+        LoadLayout(layout);
     }
 
-    void DrawFloor(Shader& shader) {
-        shader.setInt("useTexture", 1);
-        shader.setInt("texture_diffuse1", 0);
+    template <int W, int H>
+    void LoadLayout(const MazeGrid<W, H>& grid) {
+        cols = W;
+        rows = H;
+        occupancy.assign(grid.bits, grid.bits + MazeGrid<W, H>::WORDS);
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, floorTextureID);
-
-        float centerX = startPosition.x + (mazeWidth / 2.0f) - (blockSize / 2.0f);
-        float centerZ = startPosition.z + (mazeDepth / 2.0f) - (blockSize / 2.0f);
-
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(centerX, startPosition.y, centerZ));
-        shader.setMat4("model", model);
-        floorSlabMesh->Draw(shader);
+        mazeWidth = cols * blockSize;
+        mazeDepth = rows * blockSize;
     }
 
+    // Poza map nie ma cian
+    bool IsWall(int col, int row) const {
+        if (col < 0 || row < 0 || col >= cols || row >= rows) return false;
+        int i = row * cols + col;
+        return (occupancy[i >> 6] >> (i & 63)) & 1u;
+    }
 
-    void Draw(Shader& shader) {
-        shader.setInt("useTexture", 1);
-        shader.setInt("texture_diffuse1", 0);
-        shader.setInt("useWorldUV", 1);
-        shader.setFloat("texWorldSize", 2.0f); // testuj: 1.5 / 2 / 3
-
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, wallTextureID);
-
-
-        for (const auto& w : walls) {
-            glm::mat4 model = glm::mat4(1.0f);
-
-            
-            float wallHeight = 5.0f;
-            float yPos = startPosition.y + (wallHeight / 2.0f);
+    // Zachanne czenie: najduszy odcinek w wierszu, potem w d tak dugo, jak cay odcinek to ciany
+    std::vector<WallBox> MergeWalls() const {
+        std::vector<WallBox> boxes;
+        std::vector<bool> used(cols * rows, false);
+        for (int row = 0; row < rows; ++row) {
+            for (int col = 0; col < cols; ++col) {
+                if (!IsWall(col, row) || used[row * cols + col]) continue;
+
+                int w = 1;
+                while (col + w < cols && IsWall(col + w, row) && !used[row * cols + col + w]) w++;
+
+                int d = 1;
+                for (bool grow = true; grow && row + d < rows; ) {
+                    for (int c = col; c < col + w; ++c) {
+                        if (!IsWall(c, row + d) || used[(row + d) * cols + c]) { grow = false; break; }
+                    }
+                    if (grow) d++;
+                }
 
-            model = glm::translate(model, glm::vec3(w.x, yPos, w.z));
-            model = glm::scale(model, glm::vec3(blockSize, wallHeight, blockSize));
+                for (int r = row; r < row + d; ++r)
+                    for (int c = col; c < col + w; ++c)
+                        used[r * cols + c] = true;
 
-            shader.setMat4("model", model);
-            cubeMesh->Draw(shader);
+                boxes.push_back({ col, row, w, d });
+            }
         }
-        shader.setInt("useWorldUV", 0);
-
+        return boxes;
     }
 
+    // Siatki i tekstury (MazeDraw.cpp) - wywoa po utworzeniu kontekstu OpenGL
+    void InitGraphics();
+    void SubmitFloor(RenderQueue& queue);
+    void Submit(RenderQueue& queue);
+
     void checkCollision(glm::vec3& playerPos, const glm::vec3& oldPos) {
         float playerRadius = 0.4f;
         float wallHalf = blockSize / 2.0f;
@@ -244,15 +121,29 @@ public:
             return;
         }
 
-        for (const auto& w : walls) {
-            if (playerPos.x + playerRadius > w.x - wallHalf &&
-                playerPos.x - playerRadius < w.x + wallHalf &&
-                playerPos.z + playerRadius > w.z - wallHalf &&
-                playerPos.z - playerRadius < w.z + wallHalf) {
-
-                playerPos.x = oldPos.x;
-                playerPos.z = oldPos.z;
-                return;
+        // Pola pod promieniem jajka (2-4 komrki), rodek pola (col,row) to startPosition + col*blockSize
+        float originX = startPosition.x - wallHalf;
+        float originZ = startPosition.z - wallHalf;
+        int col0 = (int)std::floor((playerPos.x - playerRadius - originX) / blockSize);
+        int col1 = (int)std::floor((playerPos.x + playerRadius - originX) / blockSize);
+        int row0 = (int)std::floor((playerPos.z - playerRadius - originZ) / blockSize);
+        int row1 = (int)std::floor((playerPos.z + playerRadius - originZ) / blockSize);
+
+        for (int row = row0; row <= row1; ++row) {
+            for (int col = col0; col <= col1; ++col) {
+                if (!IsWall(col, row)) continue;
+
+                float wx = startPosition.x + col * blockSize;
+                float wz = startPosition.z + row * blockSize;
+                if (playerPos.x + playerRadius > wx - wallHalf &&
+                    playerPos.x - playerRadius < wx + wallHalf &&
+                    playerPos.z + playerRadius > wz - wallHalf &&
+                    playerPos.z - playerRadius < wz + wallHalf) {
+
+                    playerPos.x = oldPos.x;
+                    playerPos.z = oldPos.z;
+                    return;
+                }
             }
         }
     }
@@ -0,0 +1,39 @@
+#ifndef MAZE_GRID_H
+#define MAZE_GRID_H
+
+#include <cstdint>
+
+// Mapa zajętości labiryntu upakowana po 1 bicie na pole (wiersz po wierszu).
+// Wszystko constexpr - układ zapisany tekstem zamienia się w bity już przy kompilacji.
+template <int W, int H>
+struct MazeGrid {
+    static constexpr int WIDTH = W;
+    static constexpr int HEIGHT = H;
+    static constexpr int WORDS = (W * H + 63) / 64;
+
+    uint64_t bits[WORDS] = {};
+
+    constexpr bool Get(int col, int row) const {
+        int i = row * W + col;
+        return (bits[i >> 6] >> (i & 63)) & 1u;
+    }
+
+    constexpr void Set(int col, int row) {
+        int i = row * W + col;
+        bits[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+};
+
+// Układ jak w edytorze: H napisów po W znaków, spacja = wolne pole, każdy inny znak = ściana
+template <int W, int H>
+constexpr MazeGrid<W, H> ParseMazeLayout(const char* const (&rows)[H]) {
+    MazeGrid<W, H> grid;
+    for (int row = 0; row < H; ++row) {
+        for (int col = 0; col < W; ++col) {
+            if (rows[row][col] != ' ') grid.Set(col, row);
+        }
+    }
+    return grid;
+}
+
+#endif
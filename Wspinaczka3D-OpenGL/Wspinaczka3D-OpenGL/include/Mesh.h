@@ -6,6 +6,8 @@
 #include <string>
 #include <vector>
 #include <glad/glad.h>
+#include "Material.h"
+#include "Bounds.h"
 
 class Shader;
 
@@ -15,25 +17,57 @@ struct Vertex {
     glm::vec2 TexCoords;
 };
 
-struct Texture {
-    unsigned int id;
-    std::string type;
-    std::string path;
+// Uproszczona wersja siatki z tymi samymi wierzchołkami (MeshSimplifier)
+struct LodLevel {
+    std::vector<unsigned int> indices;
+    float error; // największe przesunięcie powierzchni względem oryginału (jednostki modelu)
+};
+
+// Zakres indeksów jednego poziomu w EBO siatki
+struct MeshLod {
+    unsigned int first;
+    unsigned int count;
+    float error;
 };
 
 class Mesh {
 public:
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
-    std::vector<Texture> textures;
+    Material material;
     unsigned int VAO;
 
-    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures);
+    // Granice w przestrzeni modelu, liczone raz przy tworzeniu (do cullingu)
+    AABB bounds;
+    BoundingSphere sphere;
+
+    // Poziomy szczegółów: [0] = cała siatka (indices), dalej coraz prostsze - wszystkie w jednym EBO
+    std::vector<MeshLod> lods;
+
+    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, const Material& material,
+        const std::vector<LodLevel>& lodChain = std::vector<LodLevel>());
+    // Z gotowymi granicami (np. z MeshCache) - tablice przejmowane bez kopiowania
+    Mesh(std::vector<Vertex>&& vertices, std::vector<unsigned int>&& indices, const Material& material,
+        const AABB& bounds, const BoundingSphere& sphere, const std::vector<LodLevel>& lodChain);
+
+    static void ComputeBounds(const std::vector<Vertex>& vertices, AABB& bounds, BoundingSphere& sphere);
+
+    // Najprostszy poziom, którego błąd na ekranie nie przekracza maxPixels
+    // (distance - odległość od kamery, scale - skala obiektu, pixelsPerUnit - piksele na jednostkę w odległości 1)
+    int SelectLod(float distance, float scale, float pixelsPerUnit, float maxPixels) const;
     void Draw(Shader& shader);
+    // Jedno wywołanie dla wielu kopii - macierze i kolory z bufora instancji (InstanceBuffer)
+    void DrawInstanced(Shader& shader, unsigned int instanceVBO, int count);
+
+    // Dla RenderQueue: VAO (i tekstura) już podpięte, tylko samo wywołanie rysowania
+    void DrawBound(int lod = 0) const;
+    void DrawBoundInstanced(unsigned int instanceVBO, int count, int firstInstance = 0, int lod = 0) const;
+    // Kopie z macierzą obiektu przesunięte o pozycje z PositionBuffer
+    void DrawBoundAt(unsigned int positionVBO, int count, int lod = 0) const;
 
 private:
     unsigned int VBO, EBO;
-    void setupMesh();
+    void setupMesh(const std::vector<LodLevel>& lodChain);
 };
 
 #endif
@@ -0,0 +1,32 @@
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Mesh.h"
+
+// Siatka gotowa do wysłania na GPU - wynik importu (ObjLoader / Assimp) albo odczytu z cache
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    std::vector<LodLevel> lods;
+    AABB bounds;
+    BoundingSphere sphere;
+    std::string textures[TEXTURE_SLOT_COUNT]; // plik tekstury względem katalogu modelu ("" = brak)
+};
+
+// Binarny cache zaimportowanych modeli (plik "<model>.meshcache" obok źródła albo w paczce zasobów).
+// Pierwsze uruchomienie zapisuje wynik importu (wierzchołki, indeksy, poziomy LOD, granice, tekstury),
+// kolejne mapują plik do pamięci i kopiują tablice bez żadnego parsowania.
+// Cache jest ważny tylko dla tego samego pliku źródłowego (hash zawartości) i tej samej wersji importu.
+namespace MeshCache {
+    // Zmienić przy każdej zmianie importu (flagi Assimp, ObjLoader, LOD, układ Vertex) - stare pliki przestaną pasować
+    const uint32_t VERSION = 2;
+
+    // false gdy pliku nie ma, jest uszkodzony albo jest z innego źródła/wersji (meshes bez zmian)
+    bool Load(const std::string& cachePath, uint64_t sourceHash, std::vector<MeshData>& meshes);
+    bool Save(const std::string& cachePath, uint64_t sourceHash, const std::vector<MeshData>& meshes);
+}
+
+#endif
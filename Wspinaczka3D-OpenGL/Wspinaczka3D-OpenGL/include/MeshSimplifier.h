@@ -0,0 +1,21 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include <vector>
+#include "Mesh.h"
+
+// Upraszczanie siatek metodą kwadryk (Garland-Heckbert), bez OpenGL.
+// Krawędzie są zwijane do jednego z istniejących wierzchołków, więc uproszczona siatka to tylko
+// nowa lista indeksów do tego samego bufora wierzchołków. Wierzchołki o tej samej pozycji
+// (szwy UV, siatki bez wspólnych wierzchołków z importu) są traktowane jako jeden,
+// a krawędzie brzegowe nie są ruszane.
+
+// Zwraca indeksy z co najwyżej targetIndexCount (o ile się da) i błąd (odległość w jednostkach modelu)
+std::vector<unsigned int> SimplifyMesh(const std::vector<Vertex>& vertices,
+    const std::vector<unsigned int>& indices, size_t targetIndexCount, float* error = nullptr);
+
+// Kolejne poziomy mniej więcej o połowę mniejsze, aż do minTriangles albo maxLevels poziomów
+std::vector<LodLevel> BuildLodChain(const std::vector<Vertex>& vertices,
+    const std::vector<unsigned int>& indices, int maxLevels = 4, size_t minTriangles = 64);
+
+#endif
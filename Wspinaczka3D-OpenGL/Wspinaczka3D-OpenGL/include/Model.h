@@ -10,6 +10,10 @@
 
 #include "Mesh.h"
 #include "Shader.h"
+#include "InstanceBuffer.h"
+#include "MeshSimplifier.h"
+#include "MeshCache.h"
+#include "TextureManager.h"
 
 #include <string>
 #include <fstream>
@@ -18,35 +22,68 @@
 #include <map>
 #include <vector>
 
-unsigned int TextureFromFile(const char* path, const std::string& directory);
-
 class Model
 {
 public:
     // model data 
-    std::vector<Texture> textures_loaded;	// <--- TEGO BRAKOWAO! (Cache tekstur)
+    std::vector<TextureHandle> textures; // tekstury materiaw (TextureManager) - trzymane tak dugo jak model
     std::vector<Mesh>    meshes;
     std::string directory;
     bool gammaCorrection;
+    AABB bounds; // suma granic wszystkich siatek
+    std::vector<float> lodErrors; // bd kadego poziomu szczegw dla caego modelu ([0] = 0)
+
+    // Od ilu trjktw siatka dostaje uproszczone poziomy przy imporcie
+    static const size_t LOD_MIN_TRIANGLES = 2048;
 
     // constructor, expects a filepath to a 3D model.
     Model(std::string const& path);
+    // Pusty model do wypenienia przez Build (np. z AssetLoader)
+    Model() {}
+
+    // Import bez OpenGL: z binarnego cache (MeshCache) albo, gdy go brak lub jest nieaktualny,
+    // z pliku (.obj przez ObjLoader, reszta przez ASSIMP) i zapis cache. Mona woa z wtku roboczego; pusty wynik = bd.
+    // threads = wtki parsera .obj (0 = liczba rdzeni) - z wtkw roboczych AssetLoader 1.
+    static std::vector<MeshData> Import(std::string const& path, int threads = 0);
+    // Na wtku GL: tekstury i bufory siatek z wyniku Import (tablice s przejmowane)
+    void Build(std::string const& path, std::vector<MeshData>& data);
+
+    // cieka pliku tekstury z MeshData::textures dla modelu z podanego pliku
+    static std::string TexturePath(std::string const& modelPath, std::string const& filename);
 
     // draws the model, and thus all its meshes
     void Draw(Shader& shader);
 
+    // Wszystkie kopie modelu jednym wywoaniem na siatk (macierz + kolor na instancj).
+    // Wersja z tablic wysya dane do wasnego bufora modelu, druga rysuje z gotowego bufora.
+    void DrawInstanced(Shader& shader, const InstanceData* instances, int count);
+    void DrawInstanced(Shader& shader, const InstanceBuffer& buffer, int count);
+
+    // Poziom szczegw caego modelu (jak Mesh::SelectLod; siatka bierze min(poziom, swj ostatni))
+    int SelectLod(float distance, float scale, float pixelsPerUnit, float maxPixels) const;
+
+    // Wysya kopie do wasnego bufora modelu - bufor jest jeden, wic kade wysanie nadpisuje poprzednie
+    // (RenderQueue zbiera kopie we wasnym buforze klatki)
+    const InstanceBuffer& UploadInstances(const InstanceData* instances, int count);
+
 private:
-    // loads a model with supported ASSIMP extensions from file and stores the resulting meshes in the meshes vector.
-    void loadModel(std::string const& path);
+    InstanceBuffer instanceBuffer;
+
+    // ASSIMP -> MeshData bez LOD i granic; false (z wypisanym bdem) gdy pliku nie da si wczyta
+    static bool importAssimp(std::string const& path, std::vector<MeshData>& data);
+    // Poziomy LOD i granice siatki - wsplne dla ObjLoader i ASSIMP
+    static void finishMesh(MeshData& data);
 
     // processes a node in a recursive fashion. Processes each individual mesh located at the node and repeats this process on its children nodes (if any).
-    void processNode(aiNode* node, const aiScene* scene);
+    static void processNode(aiNode* node, const aiScene* scene, std::vector<MeshData>& out);
+
+    static MeshData processMesh(aiMesh* mesh, const aiScene* scene);
 
-    Mesh processMesh(aiMesh* mesh, const aiScene* scene);
+    // file name of the first texture of the given type (or of the fallback type), "" when the material has no such map.
+    static std::string materialTexturePath(aiMaterial* mat, aiTextureType type, aiTextureType fallback);
 
-    // checks all material textures of a given type and loads the textures if they're not loaded yet.
-    // the required info is returned as a Texture struct.
-    std::vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName);
+    // loads a texture from the model directory through the TextureManager. returns the GL texture id.
+    unsigned int loadTexture(const std::string& filename);
 };
 
 #endif
\ No newline at end of file
@@ -4,9 +4,10 @@
 
 #include <glm/glm.hpp>
 #include <vector>
-#include "Mesh.h"
-#include "Shader.h"
-#include "Physics.h"
+#include "Hitbox.h"
+
+class RenderQueue;
+class Mesh;
 
 class MovingWallCourse {
 public:
@@ -33,22 +34,14 @@ public:
     float wallThickness = 0.6f;
     float midPillarWidth = 1.2f;
 
-
-    unsigned int wallTexture;
-    unsigned int floorTexture;
-
-    Mesh* cubeMesh;
-    Mesh* floorMesh;
-
     std::vector<Wall> walls;
 
-    MovingWallCourse(glm::vec3 pos,
-        unsigned int wallTex,
-        unsigned int floorTex,
-        Mesh* cube);
+    MovingWallCourse(glm::vec3 pos);
 
     void Update(float time);
-    void Draw(Shader& shader);
+    // Droga i ciany rysowane szecianem labiryntu (cube), z jego teksturami
+    // wallZ - pozycje cian do narysowania (interpolowane midzy krokami fizyki)
+    void Submit(RenderQueue& queue, Mesh& cube, unsigned int wallTexture, unsigned int floorTexture, const std::vector<float>& wallZ);
 
     // Zwraca true jeli gracz trafi w ZY otwr
     bool CheckPlayer(const glm::vec3& playerPos, float radius);
@@ -0,0 +1,23 @@
+#ifndef OBJ_LOADER_H
+#define OBJ_LOADER_H
+
+#include <string>
+#include <vector>
+#include "MeshCache.h"
+
+// Własny import plików .obj (z .mtl) zamiast Assimp - Model::Import wybiera go dla każdego .obj.
+// Plik (przez Vfs - z paczki albo z dysku) jest dzielony na kawałki po pełnych liniach, parsowane równolegle;
+// takie same narożniki (pozycja/UV/normalna) dają jeden wierzchołek. Wynik jak z Assimp z flagami
+// Triangulate | FlipUVs | GenSmoothNormals: siatka na każdy obiekt i zmianę materiału,
+// wielokąty dzielone wachlarzem, V odwrócone, brakujące normalne wygładzone po pozycjach.
+// Poziomy LOD i granice dolicza Model (tak samo jak dla Assimp).
+namespace ObjLoader {
+    // threads = 0 -> liczba rdzeni (małe pliki i tak w jednym wątku).
+    // false gdy pliku nie ma, ma błędne indeksy albo nie ma w nim żadnej ściany (błąd wypisany)
+    bool Load(const std::string& path, std::vector<MeshData>& meshes, int threads = 0);
+
+    // Nazwy plików z linii "mtllib" (względem katalogu modelu) - do klucza MeshCache
+    std::vector<std::string> MaterialLibraries(const unsigned char* data, size_t size);
+}
+
+#endif
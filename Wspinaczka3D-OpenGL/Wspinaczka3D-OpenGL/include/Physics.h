@@ -3,7 +3,7 @@
 
 #include <glm/glm.hpp>
 #include <cmath>
-#include "WinZone.h" 
+#include "Hitbox.h"
 
 class Physics {
 public:
@@ -51,20 +51,6 @@ public:
         return pos.x > t.minX && pos.x < t.maxX &&
             pos.z > t.minZ && pos.z < t.maxZ;
     }
-
-    bool CheckHorizontalCollision(glm::vec3& currentPos, const glm::vec3& oldPos, const TableHitbox& t) {
-        float restingCenterY = t.topY + EGG_HALF_HEIGHT;
-        // Jeśli jesteśmy nad obiektem, to nie jest to ściana
-        if (currentPos.y > restingCenterY - 0.05f) return false;
-
-        // Jeśli weszliśmy w obrys -> cofamy ruch
-        if (IsInsideXZ(currentPos, t)) {
-            currentPos.x = oldPos.x;
-            currentPos.z = oldPos.z;
-            return true;
-        }
-        return false;
-    }
 };
 
 #endif
\ No newline at end of file
@@ -3,9 +3,10 @@
 
 #include <vector>
 #include <random>
+#include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include "Shader.h"
+#include "RenderQueue.h"
 
 class Player {
 private:
@@ -111,40 +112,45 @@ public:
         glBufferData(GL_ARRAY_BUFFER, crackVertices.size() * sizeof(float), crackVertices.empty() ? nullptr : crackVertices.data(), GL_DYNAMIC_DRAW);
     }
 
-    void Draw(Shader& shader, glm::vec3 pos, bool crashed, float timeElapsed, float animationDuration) {
+    void Submit(RenderQueue& queue, glm::vec3 pos, bool crashed, float timeElapsed, float animationDuration) {
+        DrawState state;
+        state.useTexture = false;
+        state.color = glm::vec4(1.0f, 0.9f, 0.7f, 1.0f);
+
         if (!crashed) {
-            // Rysuj ca�e jajko
-            shader.setInt("useTexture", 0);
-            shader.setMat4("model", glm::translate(glm::mat4(1.0f), pos));
-            shader.setVec4("objectColor", glm::vec4(1.0f, 0.9f, 0.7f, 1.0f));
-            glBindVertexArray(eggVAO);
-            glDrawElements(GL_TRIANGLES, (GLsizei)eggIndices.size(), GL_UNSIGNED_INT, 0);
+            // Rysuj całe jajko
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), pos);
+            AABB eggBounds(pos - glm::vec3(0.5f, 0.7f, 0.5f), pos + glm::vec3(0.5f, 0.7f, 0.5f));
+            GLsizei eggCount = (GLsizei)eggIndices.size();
+            queue.SubmitRaw(eggVAO, 0, model, state, [eggCount] {
+                glDrawElements(GL_TRIANGLES, eggCount, GL_UNSIGNED_INT, 0);
+            }, eggBounds);
 
-            // Rysuj p�kni�cia
+            // Rysuj pęknięcia
             if (!crackVertices.empty()) {
-                shader.setVec4("objectColor", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
-                glBindVertexArray(crackVAO);
-                glLineWidth(3.0f);
-                glDrawArrays(GL_LINES, 0, (GLsizei)crackVertices.size() / 3);
-                glLineWidth(1.0f);
+                DrawState crackState = state;
+                crackState.color = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+                GLsizei crackCount = (GLsizei)crackVertices.size() / 3;
+                queue.SubmitRaw(crackVAO, 0, model, crackState, [crackCount] {
+                    glLineWidth(3.0f);
+                    glDrawArrays(GL_LINES, 0, crackCount);
+                    glLineWidth(1.0f);
+                }, eggBounds);
             }
         }
         else {
             // Rysuj wybuch (fragmenty)
             float ratio = timeElapsed / animationDuration;
             if (ratio < 1.0f) {
-                glBindVertexArray(cubeVAO);
-                shader.setInt("useTexture", 0);
-                shader.setVec4("objectColor", glm::vec4(1.0f, 0.9f, 0.7f, 1.0f));
                 for (int i = 0; i < 5; ++i) {
                     glm::mat4 m = glm::translate(glm::mat4(1.0f), pos + fragments[i] * 3.0f * (1.0f - ratio) * timeElapsed);
                     m = glm::translate(m, glm::vec3(0.0f, -5.0f * pow(timeElapsed, 2), 0.0f)); // grawitacja
-                    shader.setMat4("model", glm::scale(m, glm::vec3(glm::mix(0.1f, 0.0f, ratio))));
-                    glDrawArrays(GL_TRIANGLES, 0, 36);
+                    queue.SubmitRaw(cubeVAO, 0, glm::scale(m, glm::vec3(glm::mix(0.1f, 0.0f, ratio))), state, [] {
+                        glDrawArrays(GL_TRIANGLES, 0, 36);
+                    });
                 }
             }
         }
-        glBindVertexArray(0);
     }
 };
 
@@ -0,0 +1,143 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Material.h"
+#include "Bounds.h"
+#include "InstanceBuffer.h"
+
+class Shader;
+class Mesh;
+class Model;
+
+enum RenderPass { PASS_OPAQUE = 0, PASS_TRANSPARENT = 1 };
+
+// Które obiekty rysuje Flush - przebieg cieni dzieli scenę na zapamiętaną część statyczną i resztę
+enum CasterFilter { CASTERS_ALL, CASTERS_STATIC, CASTERS_DYNAMIC };
+
+// Uniformy materiału dla jednego rysowania - kolejka ustawia je przed każdym elementem,
+// Shader sam pomija te, które się nie zmieniły
+struct DrawState {
+    glm::vec4 color = glm::vec4(1.0f);
+    bool useTexture = true;
+    bool useWorldUV = false;
+    float texWorldSize = 2.0f;
+    bool twoSided = false;
+    bool forceUpNormal = false;
+    RenderPass pass = PASS_OPAQUE;
+    bool staticCaster = false; // nigdy się nie rusza - cień rysowany raz do mapy statycznej
+};
+
+// Obiekty sceny zgłaszają rysowania zamiast rysować od razu; Flush sortuje je tak,
+// żeby jak najrzadziej zmieniać blending, teksturę i VAO. Ta sama kolejka idzie
+// do cieni i do zwykłego przebiegu (program wybiera przebieg).
+// Granice siatek są sprawdzane z bryłą widzenia kamery (zwykły przebieg) i światła (cienie);
+// coś, czego nie widzi żadna z nich, nie trafia nawet do kolejki. Wyjątkiem są obiekty statyczne
+// (staticCaster): zostają zawsze, bo ShadowMap przerysowuje z nich zapamiętane kaskady tylko co
+// kilka klatek i odrzuca je wtedy bryłą samej kaskady.
+// Macierze model i normalnych wszystkich zgłoszonych obiektów idą raz na klatkę do jednego
+// bufora tekstury (samplerBuffer "transforms"), a kopie zgłoszone tablicą do jednego bufora
+// instancji - wszystkie Flush z klatki je współdzielą.
+class RenderQueue {
+public:
+    // Jednostka tekstury bufora macierzy (0-2, 4 zajmuje Material, 3 mapa cieni)
+    static const int TRANSFORM_UNIT = 5;
+    // Teksele RGBA32F na obiekt: 4 kolumny model + 3 kolumny macierzy normalnych
+    static const int TRANSFORM_TEXELS = 7;
+
+    // Pozycja kamery do liczenia głębi (przód->tył dla nieprzezroczystych, odwrotnie dla przezroczystych)
+    // i bryły widzenia obu przebiegów
+    void Begin(const glm::vec3& viewPos, const Frustum& cameraFrustum, const Frustum& lightFrustum);
+
+    // texture = 0 -> materiał siatki, inaczej sama ta tekstura na jednostce 0
+    void Submit(Mesh& mesh, const glm::mat4& model, const DrawState& state, unsigned int texture = 0);
+    void Submit(Model& model, const glm::mat4& transform, const DrawState& state);
+
+    // Kopie z gotowego bufora instancji (bufor musi żyć do Flush); bounds = granice wszystkich kopii w świecie
+    void SubmitInstanced(Mesh& mesh, const InstanceBuffer& buffer, int count, const DrawState& state,
+        const AABB& bounds = AABB());
+    void SubmitInstanced(Model& model, const InstanceBuffer& buffer, int count, const DrawState& state,
+        const AABB& bounds = AABB());
+    // Dane kopiowane do wspólnego bufora instancji klatki (wysyłany razem z macierzami przy pierwszym Flush),
+    // więc ten sam model można tak zgłosić kilka razy w klatce. Kopie poza obiema bryłami widzenia są odrzucane.
+    void SubmitInstanced(Model& model, const InstanceData* instances, int count, const DrawState& state);
+    // Kopie o wspólnej macierzy model i kolorze (state.color), przesunięte o pozycje z bufora
+    // (bufor musi żyć do Flush); bounds = granice wszystkich kopii w świecie
+    void SubmitAt(Mesh& mesh, const PositionBuffer& positions, int count, const glm::mat4& model,
+        const DrawState& state, const AABB& bounds);
+
+    // Geometria bez Mesh (własne VAO): kolejka podpina VAO, teksturę i uniformy,
+    // drawCall woła już tylko glDraw*
+    void SubmitRaw(unsigned int vao, unsigned int texture, const glm::mat4& model, const DrawState& state,
+        std::function<void()> drawCall, const AABB& bounds = AABB());
+
+    // depthOnly = przebieg cieni: bez blendingu i uniformów materiału, sortowanie tylko po VAO.
+    // frustum = nullptr -> bryła z Begin (kamery albo światła); kaskady cieni podają swoją.
+    void Flush(Shader& shader, bool depthOnly, CasterFilter casters = CASTERS_ALL, const Frustum* frustum = nullptr);
+
+    // Poziomy szczegółów: wysokość ekranu i kąt widzenia kamery (bez wywołania zawsze pełne siatki)
+    void SetLodMetric(float screenHeight, float fovY);
+    float lodMaxPixels = 1.0f;       // dopuszczalny błąd uproszczonej siatki na ekranie
+    float shadowLodMaxPixels = 4.0f; // w cieniu widać mniej - prostsze siatki
+
+    // Ile razy w ostatnim Flush zmieniły się tekstury / VAO, ile elementów odpadło na bryle widzenia
+    // i ile trójkątów z siatek narysowano
+    int textureBinds = 0;
+    int vaoBinds = 0;
+    int culled = 0;
+    int triangles = 0;
+
+private:
+    struct DrawItem {
+        Mesh* mesh;
+        std::function<void()> drawCall;
+        unsigned int vao;
+        unsigned int texture;      // nadpisana tekstura albo diffuse materiału (do klucza)
+        const Material* material;  // nullptr = tylko texture
+        glm::mat4 model;
+        DrawState state;
+        const InstanceBuffer* instances;
+        int instanceCount;
+        float depth;
+        AABB bounds;            // w świecie; pusty = zawsze rysuj
+        BoundingSphere sphere;
+        int transformIndex = -1; // miejsce macierzy w buforze (rysowania bez instancji)
+        int firstInstance = 0;   // początek kopii w buforze instancji
+        int lod[2] = { 0, 0 };   // poziom szczegółów: zwykły przebieg, cienie
+        const PositionBuffer* positions = nullptr; // SubmitAt: instanceCount kopii z macierzą model
+    };
+
+    // Widoczna kopia przy dzieleniu instancji na grupy o tym samym poziomie szczegółów
+    struct VisibleInstance {
+        int lodKey;
+        int index;
+        AABB bounds;
+    };
+
+    glm::vec3 viewPos = glm::vec3(0.0f);
+    Frustum cameraFrustum;
+    Frustum lightFrustum;
+    std::vector<VisibleInstance> instanceOrder;
+    float lodPixelsPerUnit = 0.0f;
+
+    // Bufor macierzy i bufor instancji klatki - wysyłane przy pierwszym Flush po Begin
+    std::vector<glm::vec4> transforms;
+    std::vector<InstanceData> frameInstances; // kopie z SubmitInstanced(tablica), każde zgłoszenie od swojego miejsca
+    bool transformsUploaded = false;
+    unsigned int transformVBO = 0, transformTexture = 0;
+    InstanceBuffer frameInstanceBuffer;
+    void uploadTransforms();
+    std::vector<DrawItem> items;
+    std::vector<std::pair<uint64_t, int>> order;
+
+    bool visible(const AABB& bounds) const;
+    void pushInstanced(Mesh& mesh, const InstanceBuffer& buffer, int first, int count, const DrawState& state,
+        const AABB& bounds, int lod, int shadowLod);
+    void push(DrawItem item);
+    static uint64_t sortKey(const DrawItem& item, bool depthOnly);
+};
+
+#endif
@@ -3,22 +3,72 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <string>
+#include <vector>
+#include <cstdint>
+
+// Indeks uniformu w tabeli shadera (-1 = shader go nie używa, set jest wtedy pustą operacją)
+typedef int UniformHandle;
 
 class Shader {
 public:
     unsigned int ID;
+    unsigned int materialSlots = 0; // sloty Material, które program próbkuje (samplery ustawione przy linkowaniu)
+
+    // Liczniki wywołań glUniform* - ile poszło do sterownika, a ile pominięto bo wartość się nie zmieniła
+    struct UniformStats {
+        unsigned int issued = 0;
+        unsigned int skipped = 0;
+    };
 
     Shader(const char* vertexPath, const char* fragmentPath);
 
     void use();
-    void setMat4(const std::string& name, const glm::mat4& mat) const;
-    void setVec3(const std::string& name, const glm::vec3& value) const;
-    void setInt(const std::string& name, int value) const;
-    void setFloat(const std::string& name, float value) const;
-    void setVec4(const std::string& name, const glm::vec4& value) const;
 
+    // Uchwyt szukamy raz (np. przed pętlą), potem set() nie porównuje już nazw
+    UniformHandle uniform(const char* name) const;
+
+    void set(UniformHandle handle, const glm::mat4& mat) const;
+    void set(UniformHandle handle, const glm::vec3& value) const;
+    void set(UniformHandle handle, const glm::vec4& value) const;
+    void set(UniformHandle handle, int value) const;
+    void set(UniformHandle handle, float value) const;
+
+    void setMat4(const char* name, const glm::mat4& mat) const { set(uniform(name), mat); }
+    void setVec3(const char* name, const glm::vec3& value) const { set(uniform(name), value); }
+    void setInt(const char* name, int value) const { set(uniform(name), value); }
+    void setFloat(const char* name, float value) const { set(uniform(name), value); }
+    void setVec4(const char* name, const glm::vec4& value) const { set(uniform(name), value); }
+
+    void setMat4(const std::string& name, const glm::mat4& mat) const { setMat4(name.c_str(), mat); }
+    void setVec3(const std::string& name, const glm::vec3& value) const { setVec3(name.c_str(), value); }
+    void setInt(const std::string& name, int value) const { setInt(name.c_str(), value); }
+    void setFloat(const std::string& name, float value) const { setFloat(name.c_str(), value); }
+    void setVec4(const std::string& name, const glm::vec4& value) const { setVec4(name.c_str(), value); }
+
+    const UniformStats& Stats() const { return stats; }
+    void ResetStats() { stats = UniformStats(); }
 
 private:
+    // Aktywny uniform znaleziony przy linkowaniu + kopia ostatnio wysłanej wartości
+    struct Uniform {
+        GLint location;
+        GLenum type;
+        bool known;       // false dopóki nic nie wysłaliśmy - pierwszy set zawsze idzie do GL
+        float value[16];  // mat4 to najwięcej, int trzymamy bitowo w value[0]
+    };
+
+    // Nazwa -> uchwyt ("tab" i "tab[0]" wskazują ten sam uniform)
+    struct UniformName {
+        std::string name;
+        uint64_t hash;
+        UniformHandle handle;
+    };
+
+    mutable std::vector<Uniform> uniforms;
+    std::vector<UniformName> names;
+    mutable UniformStats stats;
+
+    void reflectUniforms();
+    bool changed(UniformHandle handle, const void* data, size_t size) const;
     void checkCompileErrors(unsigned int shader, std::string type);
 };
-
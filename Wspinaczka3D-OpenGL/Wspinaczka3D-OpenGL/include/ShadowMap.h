@@ -0,0 +1,86 @@
+#ifndef SHADOW_MAP_H
+#define SHADOW_MAP_H
+
+#include <glm/glm.hpp>
+#include "Bounds.h"
+#include "FrameUniforms.h"
+
+class RenderQueue;
+class Shader;
+
+// Filtrowanie cieni w shaderze (uniform shadowFilter) - od najtańszego do najmiększego
+enum ShadowFilter {
+    SHADOW_FILTER_HARDWARE = 0, // jedna próbka, sprzętowe PCF 2x2
+    SHADOW_FILTER_POISSON = 1,  // 8 próbek z obróconego dysku Poissona
+    SHADOW_FILTER_PCF3X3 = 2,   // 9 próbek w siatce 3x3
+    SHADOW_FILTER_COUNT
+};
+
+// Ustawienia cieni - liczba kaskad, rozdzielczość każdej z nich i filtrowanie
+struct ShadowSettings {
+    int cascadeCount = 3;
+    unsigned int resolution[MAX_SHADOW_CASCADES] = { 2048, 2048, 1024, 1024 };
+    float distance = 120.0f;    // do jakiej odległości od kamery są cienie
+    float splitLambda = 0.75f;  // 0 = równe odcinki, 1 = logarytmiczne
+    float casterMargin = 50.0f; // jak daleko w stronę światła szukamy obiektów rzucających cień
+    int cacheSnapTexels = 128;  // co ile tekseli kaskada się przesuwa (rzadziej = rzadziej przerysowujemy statyczne)
+    ShadowFilter filter = SHADOW_FILTER_PCF3X3; // można zmieniać w trakcie gry
+};
+
+// Kaskadowa mapa cieni z zapamiętaną częścią statyczną.
+// Kaskady dopasowane do kolejnych odcinków bryły widzenia kamery leżą obok siebie w jednym atlasie.
+// Każda kaskada jest kulą wokół swojego odcinka (stały rozmiar) przesuwaną skokowo o całe teksele,
+// więc cień nie migocze przy ruchu kamery, a macierz kaskady zmienia się rzadko.
+// Nieruchome obiekty (DrawState::staticCaster) są rysowane do osobnego atlasu tylko dla kaskad,
+// których macierz się zmieniła - kolejka trzyma je wszystkie, nie tylko widoczne z kamery. Co klatkę ten atlas jest kopiowany (blit głębi)
+// do mapy używanej w shaderze i dorysowuje się na niej już tylko ruchome obiekty.
+class ShadowMap {
+public:
+    explicit ShadowMap(const ShadowSettings& settings);
+    ~ShadowMap();
+
+    ShadowMap(const ShadowMap&) = delete;
+    ShadowMap& operator=(const ShadowMap&) = delete;
+
+    // Dopasowuje kaskady do kamery (wywołać raz na klatkę, przed Fill i Render)
+    void Update(const glm::mat4& view, float fovY, float aspect, float nearPlane, const glm::vec3& lightDir);
+
+    // Macierze, prostokąty w atlasie i granice kaskad do bloku FrameData
+    void Fill(FrameData& frame) const;
+
+    // Obszar wszystkich kaskad razem - do odrzucania obiektów już przy zgłaszaniu do kolejki
+    const Frustum& CoverFrustum() const { return coverFrustum; }
+
+    // Przebieg cieni dla kolejki z bieżącej klatki (zostawia podpięty domyślny framebuffer)
+    void Render(RenderQueue& queue, Shader& depthShader);
+
+    unsigned int DepthTexture() const { return depthMap; }
+
+    unsigned int atlasWidth = 0, atlasHeight = 0;
+    int staticRebuilds = 0; // ile razy przerysowano część statyczną którejś kaskady
+
+private:
+    struct Cascade {
+        unsigned int x = 0, size = 0;   // miejsce w atlasie (w pikselach, y = 0)
+        float splitFar = 0.0f;
+        glm::mat4 lightSpace = glm::mat4(1.0f);
+        Frustum frustum;
+        glm::mat4 cachedLightSpace = glm::mat4(0.0f);
+        bool staticValid = false;
+    };
+
+    ShadowSettings settings;
+    Cascade cascades[MAX_SHADOW_CASCADES];
+    int cascadeCount = 0;
+    Frustum coverFrustum;
+
+    unsigned int staticFBO = 0, staticDepth = 0; // tylko statyczne obiekty
+    unsigned int depthFBO = 0, depthMap = 0;     // statyczne + ruchome, czytane w shaderze
+
+    glm::mat4 fitLightSpace(const glm::vec3 corners[8], const glm::vec3& lightDir, unsigned int size, bool snap) const;
+
+    static unsigned int createDepthTexture(unsigned int width, unsigned int height);
+    static unsigned int createFramebuffer(unsigned int depthTexture);
+};
+
+#endif
@@ -6,14 +6,18 @@
 #include <glm/glm.hpp>
 
 #include "Shader.h"
+#include "TextureManager.h"
 
 class Skybox {
 public:
     // faces w kolejnoci LearnOpenGL:
     // right, left, top, bottom, front, back
     Skybox(const std::vector<std::string>& faces);
+    // ciany zdekodowane wczeniej (AssetLoader, bez odwracania w pionie), w tej samej kolejnoci
+    Skybox(const std::vector<DecodedImage>& faces);
 
-    void Draw(const glm::mat4& view, const glm::mat4& projection);
+    // Kamera z aktualnie podpitego widoku FrameUniforms
+    void Draw();
 
 private:
     unsigned int skyboxVAO = 0;
@@ -24,5 +28,6 @@ private:
 
     void setupMesh();
     unsigned int loadCubemap(const std::vector<std::string>& faces);
+    unsigned int createCubemap(const std::vector<DecodedImage>& faces);
 };
 
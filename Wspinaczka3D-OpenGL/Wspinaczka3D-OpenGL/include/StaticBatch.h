@@ -0,0 +1,41 @@
+#ifndef STATIC_BATCH_H
+#define STATIC_BATCH_H
+
+#include <glm/glm.hpp>
+#include <map>
+#include <vector>
+#include "Mesh.h"
+
+class Model;
+class RenderQueue;
+
+// Nieruchome obiekty "upieczone" do przestrzeni świata: wierzchołki wszystkich kopii
+// trafiają do jednego bufora na materiał, rysowanego jednym wywołaniem
+class StaticBatch {
+public:
+    StaticBatch() {}
+    ~StaticBatch();
+
+    StaticBatch(const StaticBatch&) = delete;
+    StaticBatch& operator=(const StaticBatch&) = delete;
+
+    // Dodaje kopię modelu w danym położeniu (przed Build)
+    void Add(const Model& model, const glm::mat4& transform);
+
+    // Tworzy siatki na GPU (wymaga kontekstu OpenGL)
+    void Build();
+
+    void Submit(RenderQueue& queue);
+
+private:
+    struct Bucket {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+    };
+
+    // Jeden bufor na materiał
+    std::map<Material, Bucket> buckets;
+    std::vector<Mesh*> meshes;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef TEXTURE_COMPRESSION_H
+#define TEXTURE_COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Formaty blokowe (bloki 4x4) obsługiwane przez OpenGL 3.3:
+// BC4/BC5 (RGTC) są w rdzeniu, BC1/BC3 wymagają GL_EXT_texture_compression_s3tc
+enum BlockFormat {
+    BLOCK_BC1 = 0, // RGB, 8 bajtów na blok (4 bity na piksel)
+    BLOCK_BC3,     // RGBA, 16 bajtów (BC1 + osobny blok alfy)
+    BLOCK_BC4,     // jeden kanał (R), 8 bajtów
+    BLOCK_BC5,     // dwa kanały (RG), 16 bajtów
+    BLOCK_FORMAT_COUNT
+};
+
+// Skompresowana tekstura z całym łańcuchem mipmap, gotowa do glCompressedTexImage2D
+struct CompressedTexture {
+    BlockFormat format = BLOCK_BC1;
+    int width = 0, height = 0;
+    bool flippedY = true; // wiersze od dołu, jak po stbi_set_flip_vertically_on_load(true)
+    uint64_t sourceHash = 0; // Fnv1a pliku źródłowego - gra odrzuca .ktx2 starszy niż obraz (0 = brak)
+    std::vector<std::vector<unsigned char>> levels; // [0] = pełny rozmiar, ostatni 1x1
+
+    bool Valid() const { return !levels.empty(); }
+    size_t Bytes() const;
+};
+
+// Kompresja (narzędzie wspinaczka_texconv) i odczyt plików .ktx2 (gra) - bez OpenGL.
+// Plik to zwykły KTX 2.0 bez superkompresji: jedna warstwa, jedna ściana, poziomy od najmniejszego,
+// orientacja w kluczu KTXorientation ("ru" = odwrócone w pionie, "rd" = jak w pliku źródłowym),
+// hash źródła w kluczu wspinaczkaSourceHash (16 cyfr szesnastkowych).
+namespace TextureCompression {
+    int BlockBytes(BlockFormat format);
+    const char* FormatName(BlockFormat format);
+    size_t LevelBytes(BlockFormat format, int width, int height);
+
+    // Format dla obrazu RGBA (rgba = width*height*4) wczytanego z pliku o danej liczbie kanałów:
+    // 1 -> BC4, 2 -> BC5, 3 -> BC1, 4 -> BC3 tylko gdy alfa naprawdę jest używana
+    BlockFormat ChooseFormat(const unsigned char* rgba, int width, int height, int channels);
+
+    // Cały łańcuch mipmap (filtr pudełkowy 2x2) skompresowany do formatu; rgba = width*height*4
+    CompressedTexture Compress(const unsigned char* rgba, int width, int height, BlockFormat format, bool flippedY);
+
+    bool WriteKtx2(const std::string& path, const CompressedTexture& texture);
+    // data = zawartość pliku (np. z Vfs::Open), path tylko do komunikatów;
+    // false gdy to nie jest obsługiwany KTX2 (błąd wypisany)
+    bool ReadKtx2(const std::string& path, const unsigned char* data, size_t size, CompressedTexture& texture);
+}
+
+#endif
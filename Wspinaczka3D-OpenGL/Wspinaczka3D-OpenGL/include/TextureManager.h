@@ -0,0 +1,215 @@
+#ifndef TEXTURE_MANAGER_H
+#define TEXTURE_MANAGER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "TextureCompression.h"
+
+// Obraz zdekodowany z pliku do pamięci - Decode można wołać z dowolnego wątku.
+// Jeśli obok pliku leży "<plik>.ktx2" (wspinaczka_texconv) w obsługiwanym formacie, obraz ma
+// gotowe skompresowane poziomy zamiast pikseli ze stb_image.
+struct DecodedImage {
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = nullptr;
+    CompressedTexture compressed;
+
+    DecodedImage() {}
+    DecodedImage(DecodedImage&& other) noexcept;
+    DecodedImage& operator=(DecodedImage&& other) noexcept;
+    DecodedImage(const DecodedImage&) = delete;
+    DecodedImage& operator=(const DecodedImage&) = delete;
+    ~DecodedImage();
+
+    bool Valid() const { return pixels != nullptr || compressed.Valid(); }
+    size_t Bytes() const { return compressed.Valid() ? compressed.Bytes() : (size_t)width * height * channels; }
+
+    // flipVertically = true dla zwykłych tekstur (OpenGL ma początek na dole), false dla cubemap
+    static DecodedImage Decode(const std::string& path, bool flipVertically = true);
+};
+
+// Uchwyt do tekstury z TextureManager: kopia = +1 referencja, zniszczenie = -1,
+// ostatni uchwyt usuwa teksturę z GPU
+class TextureHandle {
+public:
+    TextureHandle() {}
+    TextureHandle(const TextureHandle& other);
+    TextureHandle(TextureHandle&& other) noexcept;
+    TextureHandle& operator=(TextureHandle other);
+    ~TextureHandle();
+
+    unsigned int Id() const { return id; }
+    bool Valid() const { return id != 0; }
+    void Reset();
+
+private:
+    friend class TextureManager;
+    explicit TextureHandle(unsigned int id) : id(id) {}
+    unsigned int id = 0;
+};
+
+// Ustawienia strumieniowania tekstur (TextureManager::EnableStreaming)
+struct TextureStreamSettings {
+    size_t budgetBytes = 0;                // pamięć GPU na tekstury strumieniowane; 0 = z karty albo 256 MB
+    size_t uploadBytesPerFrame = 4 << 20;  // ile najwyżej wysłać w jednej klatce (co najmniej jeden poziom)
+    int lowMipSize = 64;                   // poziomy do tego rozmiaru idą na GPU od razu, wszystkie naraz
+    float fullDetailDistance = 16.0f;      // do tej odległości pełna rozdzielczość, dalej co podwojenie poziom mniej
+    int workerThreads = 0;                 // 0 = połowa rdzeni, najwyżej 4
+};
+
+// Wszystkie tekstury 2D gry z plików (modele, ziemia, labirynt, UI).
+// Plik jest dekodowany i wysyłany na GPU tylko raz - kluczem jest hash znormalizowanej ścieżki (AssetPath),
+// więc "assets\models\a.png" i "assets/textures/../models/a.png" to ta sama tekstura.
+// Każda tekstura dostaje te same parametry: REPEAT, mipmapy, filtrowanie trójliniowe.
+//
+// Ze strumieniowaniem Load/Acquire nie czekają na plik: tekstura od razu dostaje szary teksel 1x1,
+// wątki w tle dekodują plik, a Update (raz na klatkę) wysyła najpierw małe mipmapy, potem kolejne
+// większe poziomy - najpierw dla tekstur najbliżej kamery (Touch z RenderQueue). Daleko od kamery
+// (albo niewidziana) tekstura nie dostaje pełnej rozdzielczości. Id tekstury się nie zmienia,
+// zmienia się tylko GL_TEXTURE_BASE_LEVEL. Gdy brakuje budżetu, najdalsze tekstury oddają
+// największe poziomy, ale małe mipmapy zostają zawsze.
+class TextureManager {
+public:
+    static TextureManager& Instance();
+
+    // Raz po utworzeniu kontekstu, przed wczytywaniem: które formaty blokowe obsługuje karta
+    // (BC4/BC5 zawsze, BC1/BC3 z GL_EXT_texture_compression_s3tc). Bez tego .ktx2 są pomijane.
+    static void DetectCompression();
+    static bool SupportsFormat(BlockFormat format);
+
+    // Tekstura z pliku (+1 referencja); nieudane wczytanie = pusty uchwyt (id 0).
+    // stream = false: cała tekstura od razu, także przy włączonym strumieniowaniu (np. napisy UI)
+    TextureHandle Load(const std::string& path, bool stream = true);
+
+    // To samo dla obiektów trzymających samo id (np. Maze, który nie może zależeć od OpenGL);
+    // każde Acquire wymaga jednego Release (albo Shutdown na końcu programu)
+    unsigned int Acquire(const std::string& path, bool stream = true);
+    void Release(unsigned int id);
+
+    // Tekstura zdekodowana wcześniej (AssetLoader) - trafia do cache bez referencji,
+    // a późniejsze Load/Acquire tej ścieżki już nie dekodują pliku
+    void Preload(const std::string& path, const DecodedImage& image);
+
+    // Wysyła obraz przez bufor PBO do podpiętej tekstury (target = GL_TEXTURE_2D albo ściana cubemapy);
+    // skompresowany obraz ma już wszystkie mipmapy, zwykły tylko poziom 0
+    void UploadImage(unsigned int target, const DecodedImage& image);
+
+    // Przed pierwszym Load: kolejne tekstury są strumieniowane (wątki startują tutaj)
+    void EnableStreaming(const TextureStreamSettings& settings = TextureStreamSettings());
+    bool Streaming() const { return streaming; }
+    // Tekstura jest potrzebna w tej klatce w danej odległości od kamery (najmniejsza z klatki wygrywa)
+    void Touch(unsigned int id, float distance);
+    // Raz na klatkę na wątku GL: odbiera zdekodowane pliki, pilnuje budżetu i wysyła kolejne poziomy
+    void Update();
+
+    // Usuwa wszystkie tekstury - wywołać przed zamknięciem kontekstu OpenGL.
+    // Późniejsze Release (np. z destruktorów modeli na stosie) nic już nie robią.
+    void Shutdown();
+
+    size_t TextureCount() const { return entries.size(); }
+    size_t MemoryBytes() const { return memoryBytes; }
+    size_t StreamedBytes() const { return streamedBytes; }
+    void PrintReport() const; // liczba tekstur, pamięć GPU i lista plików (z poziomem na GPU)
+
+private:
+    friend class TextureHandle;
+
+    // Pełny łańcuch mipmap zdekodowany w tle, trzymany w RAM tylko do wysłania potrzebnych poziomów
+    struct StreamSource {
+        bool compressed = false;
+        BlockFormat format = BLOCK_BC1;
+        int channels = 0;
+        int width = 0, height = 0;
+        std::vector<std::vector<unsigned char>> levels; // [0] = pełny rozmiar
+    };
+
+    struct Entry {
+        unsigned int id = 0;
+        std::string path;
+        int refs = 0;
+        int width = 0, height = 0;
+        size_t bytes = 0; // z mipmapami
+        const char* format = "";
+
+        // Strumieniowanie. Poziomy [residentLevel, levelCount) są na GPU;
+        // residentLevel == levelCount = jeszcze nic poza tekselem 1x1 (levelCount 0 = plik nie zdekodowany)
+        bool streamed = false;
+        bool decoding = false;
+        bool failed = false;
+        int levelCount = 0;
+        int residentLevel = 0;
+        int targetLevel = 0;   // ile budżet pozwala mieć na GPU
+        int lowLevel = 0;      // pierwszy poziom nie większy niż lowMipSize
+        int pendingRows = 0;   // wysłane wiersze poziomu residentLevel - 1 (duże poziomy idą w kilku klatkach)
+        std::vector<size_t> levelBytes;
+        float distance = 0.0f;
+        unsigned int touchFrame = 0;
+        std::unique_ptr<StreamSource> source;
+    };
+
+    struct StreamJob {
+        uint64_t key;
+        std::string path;
+    };
+
+    struct StreamResult {
+        uint64_t key;
+        std::unique_ptr<StreamSource> source; // nullptr = nie udało się wczytać
+    };
+
+    TextureManager() {}
+    ~TextureManager();
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    std::unordered_map<uint64_t, Entry> entries;
+    std::unordered_map<unsigned int, uint64_t> keyById;
+    size_t memoryBytes = 0;
+    size_t streamedBytes = 0; // część memoryBytes liczona do budżetu
+    bool shutDown = false;
+    static unsigned int supportedFormats; // bit = 1 << BlockFormat
+
+    bool streaming = false;
+    TextureStreamSettings streamSettings;
+    unsigned int frame = 1;
+    int decodesInFlight = 0;
+    bool streamIdleReported = false; // tylko Debug: jednorazowy raport po zakończeniu strumieniowania
+    double streamStartTime = 0.0;
+    std::vector<std::thread> streamWorkers;
+    std::deque<StreamJob> streamJobs;
+    std::vector<StreamResult> streamResults;
+    std::mutex streamMutex;
+    std::condition_variable streamReady;
+    bool streamStopping = false;
+
+    // Bufor PBO do wysyłania pikseli - przy każdym obrazie dostaje nową pamięć (orphaning),
+    // więc kopiowanie kolejnego nie czeka, aż sterownik skończy poprzedni
+    unsigned int uploadPBO = 0;
+
+    void addRef(unsigned int id);
+    void insert(uint64_t key, const std::string& path, const DecodedImage& image, int refs);
+    void insertStreamed(uint64_t key, const std::string& path, int refs);
+    const void* stage(const void* data, size_t size); // kopia do PBO; nullptr = dane w PBO od 0
+
+    static std::unique_ptr<StreamSource> buildSource(DecodedImage& image);
+    void streamWorkerLoop();
+    void stopStreaming();
+    void receiveSource(Entry& entry, std::unique_ptr<StreamSource> source);
+    void uploadLevel(const StreamSource& source, int level);
+    void allocateLevel(const StreamSource& source, int level);
+    // Kolejne wiersze poziomu (w compressed całe rzędy bloków) za najwyżej maxBytes; zwraca liczbę wierszy
+    int uploadRows(const StreamSource& source, int level, int firstRow, size_t maxBytes, size_t& bytes);
+    void dropLevel(Entry& entry);
+    void discardPending(Entry& entry);
+    // Zwalnia miejsce w budżecie zabierając poziomy teksturom ponad ich cel (od końca order)
+    bool makeRoom(size_t bytes, const std::vector<Entry*>& order);
+};
+
+#endif
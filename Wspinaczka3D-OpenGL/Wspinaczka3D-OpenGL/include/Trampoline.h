@@ -3,8 +3,9 @@
 
 #include <glm/glm.hpp>
 #include <vector>
-#include "Shader.h"
-#include "Model.h"
+
+class RenderQueue;
+class Model;
 
 class Trampoline {
 public:
@@ -15,15 +16,14 @@ public:
     float bounceForce;  // Sia wybicia
 
     // Wygld
-    Model* model;
     glm::vec3 visualScale;  // zmniejszanie/zwikszanie modelu
     glm::vec3 visualOffset; // Przesunicie modelu 
 
     // Konstruktor
-    Trampoline(glm::vec3 pos, float r, float h, float force, Model* modelRef, glm::vec3 scale, glm::vec3 offset);
+    Trampoline(glm::vec3 pos, float r, float h, float force, glm::vec3 scale, glm::vec3 offset);
 
     // Metody
-    void Draw(Shader& shader);
+    void Submit(RenderQueue& queue, Model& model);
     bool checkCollision(glm::vec3 playerPos, float& playerY, float& velocityY, float playerHalfHeight);
 };
 
@@ -0,0 +1,45 @@
+#ifndef VFS_H
+#define VFS_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "MappedFile.h"
+
+// Zawartość pliku tylko do odczytu. Plik z paczki to wskaźnik wprost w jej mapowanie (bez kopii
+// i bez wywołań systemowych), luźny plik jest mapowany osobno i zwalniany razem z widokiem.
+class FileView {
+public:
+    FileView() {}
+    FileView(const unsigned char* data, size_t size) : data(data), size(size) {}
+    explicit FileView(std::unique_ptr<MappedFile> file)
+        : data(file->Data()), size(file->Size()), loose(std::move(file)) {}
+
+    bool Valid() const { return data != nullptr; }
+    const unsigned char* Data() const { return data; }
+    size_t Size() const { return size; }
+    // true = z paczki (tylko do odczytu - nic nie zapisujemy obok takiego pliku)
+    bool Packed() const { return data && !loose; }
+
+private:
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    std::unique_ptr<MappedFile> loose;
+};
+
+// Wirtualny system plików dla wszystkich loaderów (modele, tekstury, shadery).
+// Ścieżki jak dotąd ("assets/models/ball.obj") - szukane w zamontowanej paczce (AssetPack),
+// a czego w niej nie ma, to z dysku względem katalogu roboczego.
+// Mount/Unmount przed i po wczytywaniu; Open można wołać z dowolnego wątku.
+namespace Vfs {
+    // looseOverride = luźne pliki mają pierwszeństwo przed paczką (praca nad zasobami bez pakowania);
+    // false gdy paczki nie ma - wtedy wszystko idzie z dysku
+    bool Mount(const std::string& packPath, bool looseOverride);
+    // Widoki z paczki przestają być ważne
+    void Unmount();
+
+    // Nieważny widok gdy pliku nie ma ani w paczce, ani na dysku (albo jest pusty)
+    FileView Open(const std::string& path);
+}
+
+#endif
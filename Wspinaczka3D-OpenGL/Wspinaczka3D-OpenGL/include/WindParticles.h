@@ -3,23 +3,43 @@
 #define WINDPARTICLES_H
 
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <vector>
-#include <algorithm>
-#include "Shader.h"
+#include <cmath>
+#include "RenderQueue.h"
 #include "Mesh.h"
+#include "InstanceBuffer.h"
 #include "WindyTileBridge.h"
 
+// Cząsteczki wiatru nad mostem: bufor cykliczny o stałej pojemności, dane w osobnych
+// tablicach (pozycje x/y/z i wiek) - pętla aktualizacji to proste przejście po floatach.
+// Wszystkie żyją tyle samo, więc najstarsza jest zawsze na początku (head).
+// Do GPU idą co klatkę same pozycje (12 bajtów na cząsteczkę); obrót i kolor są wspólne.
 class WindParticles {
 public:
-    std::vector<glm::vec3> particles;
-    std::vector<float> particleLifetimes;
-    Mesh* particleMesh = nullptr;
+    int capacity;
+    std::vector<float> posX, posY, posZ, age;
+    int head = 0;   // indeks najstarszej cząsteczki
+    int count = 0;  // ile żyje (kolejne indeksy od head, z zawinięciem)
+
+    float maxLifetime = 3.0f;
     float spawnTimer = 0.0f;
 
+    Mesh* particleMesh = nullptr;
+    PositionBuffer positions;
+    std::vector<glm::vec3> packed; // żyjące pozycje po kolei, do wysłania
+
     WindyTileBridge* bridge = nullptr;
 
-    WindParticles() {
-        // Mniejsze cz�steczki (0.05)
+    WindParticles(int maxParticles = 32768) {
+        capacity = maxParticles;
+        posX.resize(capacity);
+        posY.resize(capacity);
+        posZ.resize(capacity);
+        age.resize(capacity);
+        packed.resize(capacity);
+
+        // Mniejsze cząsteczki (0.05)
         std::vector<Vertex> vertices = {
             {{-0.05f, -0.05f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
             {{ 0.05f, -0.05f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},
@@ -27,114 +47,103 @@ public:
             {{-0.05f,  0.05f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}}
         };
         std::vector<unsigned int> indices = { 0, 1, 2, 2, 3, 0 };
-        particleMesh = new Mesh(vertices, indices, {});
+        particleMesh = new Mesh(vertices, indices, Material());
     }
 
     ~WindParticles() {
+        positions.Release();
         delete particleMesh;
     }
 
     void Update(float deltaTime, glm::vec3 windForce) {
-        // Spawn nowych cz�steczek tylko gdy wiatr wieje
-        if (glm::length(windForce) > 0.5f) { // Minimalna si�a wiatru
+        // Spawn nowych cząsteczek tylko gdy wiatr wieje
+        if (glm::length(windForce) > 0.5f) { // Minimalna siła wiatru
             spawnTimer += deltaTime;
             if (spawnTimer > 0.03f) { // Co 30ms
                 spawnTimer = 0.0f;
 
-                if (bridge && !bridge->tiles.empty()) {
-                    auto spawnPoints = bridge->GetParticleSpawnPoints();
-                    for (const auto& spawnPos : spawnPoints) {
-                        if (particles.size() > 200) break; // Maksymalnie 200 cz�steczek
-
-                        glm::vec3 pos = spawnPos;
-                        pos.y += 1.5f; // Nad kafelkami
-                        pos.x += (rand() % 100 / 100.0f - 0.5f) * bridge->tileSize * 0.8f;
-                        pos.z += (rand() % 100 / 100.0f - 0.5f) * bridge->tileSize * 0.8f;
-
-                        particles.push_back(pos);
-                        particleLifetimes.push_back(0.0f);
+                if (bridge) {
+                    for (const auto& tile : bridge->tiles) {
+                        if (count >= capacity) break; // Bufor pełny
+                        if (!tile.active || tile.isEndTile) continue; // Nie generuj na kafelkach mety
+
+                        int i = (head + count) % capacity;
+                        posX[i] = tile.position.x + (rand() % 100 / 100.0f - 0.5f) * bridge->tileSize * 0.8f;
+                        posY[i] = tile.position.y + 1.5f; // Nad kafelkami
+                        posZ[i] = tile.position.z + (rand() % 100 / 100.0f - 0.5f) * bridge->tileSize * 0.8f;
+                        age[i] = 0.0f;
+                        count++;
                     }
                 }
             }
         }
 
-        // Updatuj istniej�ce cz�steczki
-        for (size_t i = 0; i < particles.size(); ++i) {
-            if (i < particleLifetimes.size()) {
-                particles[i] += windForce * deltaTime * 0.8f;
-                particleLifetimes[i] += deltaTime;
-            }
-        }
+        // Żyjące cząsteczki to najwyżej dwa ciągłe kawałki tablic
+        glm::vec3 step = windForce * deltaTime * 0.8f;
+        int first = glm::min(count, capacity - head);
+        Advance(head, head + first, step, deltaTime);
+        Advance(0, count - first, step, deltaTime);
 
-        // Usuwanie starych cz�steczek (�ycie 3 sekundy)
-        float maxLifetime = 3.0f;
-        particles.erase(
-            std::remove_if(particles.begin(), particles.end(),
-                [&](glm::vec3& p) {
-                    size_t idx = &p - &particles[0];
-                    if (idx >= particleLifetimes.size()) return true;
-                    return particleLifetimes[idx] > maxLifetime;
-                }),
-            particles.end()
-        );
-
-        // Czy�� lifetimes osobno
-        particleLifetimes.erase(
-            std::remove_if(particleLifetimes.begin(), particleLifetimes.end(),
-                [&](float& lt) { return lt > maxLifetime; }),
-            particleLifetimes.end()
-        );
+        // Usuwanie starych cząsteczek (życie 3 sekundy) - od najstarszej
+        while (count > 0 && age[head] > maxLifetime) {
+            head = (head + 1) % capacity;
+            count--;
+        }
     }
 
-    void Draw(Shader& shader) {
-        if (particles.empty()) return;
-
-        // ZAPISZ STAN OPENGL
-        GLboolean blendEnabled = glIsEnabled(GL_BLEND);
-        GLboolean cullEnabled = glIsEnabled(GL_CULL_FACE);
-
-        // ZAPISZ AKTUALNE UNIFORMY
-        GLint prevUseTexture;
-        glGetUniformiv(shader.ID, glGetUniformLocation(shader.ID, "useTexture"), &prevUseTexture);
+    void Submit(RenderQueue& queue) {
+        if (count == 0) return;
 
-        glm::vec4 prevObjectColor;
-        glGetUniformfv(shader.ID, glGetUniformLocation(shader.ID, "objectColor"), &prevObjectColor[0]);
-
-        // W��CZ BLENDING I WY��CZ CULLING DLA CZ�STECZEK
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDisable(GL_CULL_FACE);
-
-        // USTAWIENIA DLA CZ�STECZEK
-        shader.setInt("useTexture", 0);
-        shader.setVec4("objectColor", glm::vec4(1.0f, 1.0f, 1.0f, 0.7f));
-
-        // RYSUJ CZ�STECZKI
-        for (size_t i = 0; i < particles.size(); ++i) {
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, particles[i]);
-
-            // Rotacja w kierunku wiatru
-            if (bridge) {
-                glm::vec2 wind = bridge->GetWindForce();
-                if (glm::length(wind) > 0.1f) {
-                    float angle = atan2(wind.y, wind.x);
-                    model = glm::rotate(model, angle, glm::vec3(0, 0, 1));
-                }
+        // Rotacja w kierunku wiatru - wspólna dla wszystkich
+        glm::mat4 rotation = glm::mat4(1.0f);
+        if (bridge) {
+            glm::vec2 wind = bridge->GetWindForce();
+            if (glm::length(wind) > 0.1f) {
+                rotation = glm::rotate(rotation, atan2(wind.y, wind.x), glm::vec3(0, 0, 1));
             }
-
-            shader.setMat4("model", model);
-            particleMesh->Draw(shader);
         }
 
-        // PRZYWR�� POPRZEDNI STAN OPENGL
-        if (!blendEnabled) glDisable(GL_BLEND);
-        if (cullEnabled) glEnable(GL_CULL_FACE);
+        // Te same dwa ciągłe kawałki co w Update, sklejone w jeden strumień
+        AABB bounds;
+        int first = glm::min(count, capacity - head);
+        Pack(head, head + first, 0, bounds);
+        Pack(0, count - first, first, bounds);
+        positions.Upload(packed.data(), count);
+
+        // Obrócona siatka cząsteczki wokół każdego środka
+        float reach = glm::length(particleMesh->bounds.HalfSize()) + glm::length(particleMesh->bounds.Center());
+        bounds.min -= glm::vec3(reach);
+        bounds.max += glm::vec3(reach);
+
+        // Przezroczyste - kolejka włącza blending i rysuje je po nieprzezroczystych
+        DrawState state;
+        state.color = glm::vec4(1.0f, 1.0f, 1.0f, 0.7f);
+        state.useTexture = false;
+        state.pass = PASS_TRANSPARENT;
+        queue.SubmitAt(*particleMesh, positions, count, rotation, state, bounds);
+    }
 
-        // PRZYWR�� POPRZEDNIE UNIFORMY
-        shader.setInt("useTexture", prevUseTexture);
-        shader.setVec4("objectColor", prevObjectColor);
+private:
+    void Advance(int begin, int end, const glm::vec3& step, float deltaTime) {
+        float* px = posX.data();
+        float* py = posY.data();
+        float* pz = posZ.data();
+        float* a = age.data();
+        for (int i = begin; i < end; ++i) {
+            px[i] += step.x;
+            py[i] += step.y;
+            pz[i] += step.z;
+            a[i] += deltaTime;
+        }
+    }
+
+    void Pack(int begin, int end, int to, AABB& bounds) {
+        glm::vec3* out = packed.data() + to;
+        for (int i = begin; i < end; ++i) {
+            *out = glm::vec3(posX[i], posY[i], posZ[i]);
+            bounds.Expand(*out++);
+        }
     }
 };
 
-#endif // WINDPARTICLES_H
\ No newline at end of file
+#endif // WINDPARTICLES_H
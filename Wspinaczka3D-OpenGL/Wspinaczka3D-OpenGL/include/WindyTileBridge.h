@@ -4,17 +4,22 @@
 #include <vector>
 #include <cstdlib>
 #include <ctime>
+#include <cmath>
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include "Model.h"
-#include "Shader.h"
-#include "Physics.h"
+#include "Hitbox.h"
+#include "InstanceBuffer.h"
+#include "Bounds.h"
+
+class RenderQueue;
+class Model;
 
 struct WindyTile {
     glm::vec3 position;
     bool active;
-    float timer;
+    float timer;      // warto w chwili stamp - dalej maleje leniwie (patrz TileTimer)
+    float stamp;      // decayClock przy ostatnim dotkniciu
     float maxTime;
+    bool warm;        // timer > 0 - kolor zmienia si co klatk
     TableHitbox hitbox;
     bool isEndTile; // kafelek prowadzcy do mety
 };
@@ -22,7 +27,6 @@ struct WindyTile {
 class WindyTileBridge {
 public:
     std::vector<WindyTile> tiles;
-    Model* tileModel;
     glm::vec3 position;
     glm::vec3 rotation;
     glm::vec3 scale;
@@ -39,14 +43,26 @@ public:
     TableHitbox bridgeBounds;
     bool isPlayerOnBridge;
 
+    // Zegar stygnicia kafelkw - pynie tylko gdy gracz jest na mocie (jak wczeniej)
+    float decayClock = 0.0f;
+    static constexpr float DECAY_RATE = 0.5f;
+
+    // Kafelki z timerem > 0 (zwykle kilka) i zakres kafelkw do przeliczenia przy rysowaniu
+    std::vector<int> warmTiles;
+    int dirtyBegin = 0;
+    int dirtyEnd = 0;
+
+    // Instancje do rysowania (WindyTileBridgeDraw.cpp) - przeliczane i wysyane tylko dla zmienionych kafelkw
+    std::vector<InstanceData> tileInstances;
+    AABB tileBounds; // granice wszystkich kafelkw (do odrzucania poza kamer)
+
     static constexpr float STAND_TIME_THRESHOLD = 3.0f;
 
-    WindyTileBridge(glm::vec3 pos, glm::vec3 rot, glm::vec3 sc, Model* modelRef,
+    WindyTileBridge(glm::vec3 pos, glm::vec3 rot, glm::vec3 sc,
         int gridX = 12, int gridZ = 25, float tileSz = 2.0f) {
         position = pos;
         rotation = rot;
         scale = sc;
-        tileModel = modelRef;
         gridSizeX = gridX;
         gridSizeZ = gridZ;
         tileSize = tileSz;
@@ -74,6 +90,8 @@ public:
                 );
                 tile.active = true;
                 tile.timer = 0.0f;
+                tile.stamp = 0.0f;
+                tile.warm = false;
                 tile.maxTime = STAND_TIME_THRESHOLD;
 
                 // Oznacz ostatnie 3 rzdy jako kafelki mety
@@ -94,6 +112,32 @@ public:
         bridgeBounds.minZ = startZ;
         bridgeBounds.maxZ = startZ + bridgeLength;
         bridgeBounds.topY = pos.y + 0.5f;
+
+        dirtyEnd = (int)tiles.size();
+    }
+
+    // Indeks kafelka pod pozycj (kafelki le kolumnami: x * gridSizeZ + z), -1 poza mostem
+    int TileIndexAt(const glm::vec3& p) const {
+        int x = (int)std::floor((p.x - bridgeBounds.minX) / tileSize);
+        int z = (int)std::floor((p.z - bridgeBounds.minZ) / tileSize);
+        if (x < 0 || z < 0 || x >= gridSizeX || z >= gridSizeZ) return -1;
+        return x * gridSizeZ + z;
+    }
+
+    // Aktualny timer kafelka z uwzgldnieniem stygnicia od ostatniego dotknicia
+    float TileTimer(const WindyTile& tile) const {
+        return TimerAt(tile, decayClock);
+    }
+
+    void MarkDirty(int i) {
+        if (dirtyBegin >= dirtyEnd) {
+            dirtyBegin = i;
+            dirtyEnd = i + 1;
+        }
+        else {
+            dirtyBegin = glm::min(dirtyBegin, i);
+            dirtyEnd = glm::max(dirtyEnd, i + 1);
+        }
     }
 
     void Update(float deltaTime, const glm::vec3& playerPos) {
@@ -109,23 +153,43 @@ public:
             playerPos.z >= bridgeBounds.minZ && playerPos.z <= bridgeBounds.maxZ &&
             playerPos.y >= bridgeBounds.topY - 3.0f);
 
-        if (isPlayerOnBridge) {
-            for (auto& tile : tiles) {
-                if (!tile.active) continue;
-
-                bool onTile = (playerPos.x >= tile.hitbox.minX && playerPos.x <= tile.hitbox.maxX &&
-                    playerPos.z >= tile.hitbox.minZ && playerPos.z <= tile.hitbox.maxZ &&
-                    fabs(playerPos.y - (tile.hitbox.topY + 0.7f)) < 0.6f);
-
-                if (onTile) {
-                    tile.timer += deltaTime;
-                    if (tile.timer >= tile.maxTime) {
-                        tile.active = false;
-                    }
+        if (!isPlayerOnBridge) return;
+        decayClock += deltaTime;
+
+        // Tylko kafelek pod graczem - reszta stygnie leniwie
+        int i = TileIndexAt(playerPos);
+        if (i >= 0) {
+            WindyTile& tile = tiles[i];
+            bool onTile = tile.active &&
+                (playerPos.x >= tile.hitbox.minX && playerPos.x <= tile.hitbox.maxX &&
+                playerPos.z >= tile.hitbox.minZ && playerPos.z <= tile.hitbox.maxZ &&
+                fabs(playerPos.y - (tile.hitbox.topY + 0.7f)) < 0.6f);
+
+            if (onTile) {
+                tile.timer = TimerAt(tile, decayClock - deltaTime) + deltaTime;
+                tile.stamp = decayClock;
+                if (tile.timer >= tile.maxTime) {
+                    tile.active = false;
                 }
-                else {
-                    tile.timer = glm::max(0.0f, tile.timer - deltaTime * 0.5f);
+                if (!tile.warm) {
+                    tile.warm = true;
+                    warmTiles.push_back(i);
                 }
+                MarkDirty(i);
+            }
+        }
+
+        // Wystyge albo zniszczone kafelki wypadaj z listy
+        for (size_t k = 0; k < warmTiles.size();) {
+            WindyTile& tile = tiles[warmTiles[k]];
+            if (!tile.active || TileTimer(tile) <= 0.0f) {
+                tile.warm = false;
+                MarkDirty(warmTiles[k]);
+                warmTiles[k] = warmTiles.back();
+                warmTiles.pop_back();
+            }
+            else {
+                k++;
             }
         }
     }
@@ -134,9 +198,9 @@ public:
         bool standing = false;
         float targetY = 0.0f;
 
-        for (auto& tile : tiles) {
-            if (!tile.active) continue;
-
+        int i = TileIndexAt(playerPos);
+        if (i >= 0 && tiles[i].active) {
+            const WindyTile& tile = tiles[i];
             if (playerPos.x >= tile.hitbox.minX && playerPos.x <= tile.hitbox.maxX &&
                 playerPos.z >= tile.hitbox.minZ && playerPos.z <= tile.hitbox.maxZ) {
 
@@ -144,7 +208,6 @@ public:
                 if (playerPos.y <= targetY + 0.5f && playerPos.y >= targetY - 0.5f) {
                     playerPos.y = targetY;
                     standing = true;
-                    break;
                 }
             }
         }
@@ -158,74 +221,22 @@ public:
         return standing;
     }
 
-    void Draw(Shader& shader) {
-        if (!tileModel) return;
-
-        shader.setInt("useTexture", 1);
-
-        for (const auto& tile : tiles) {
-            if (!tile.active) continue;
-
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, tile.position);
-
-            float visualSize = tileSize * 0.82f;
-            model = glm::scale(model, glm::vec3(visualSize, 0.5f, visualSize));
-
-            // Kolorowanie kafelkw mety
-            glm::vec4 color;
-            if (tile.isEndTile) {
-                // Fioletowe kafelki mety (zielony + czerwony = fioletowy)
-                color = glm::vec4(0.5f, 0.0f, 1.0f, 1.0f);
-            }
-            else {
-                // Normalny gradient czasowy
-                float timeRatio = glm::clamp(tile.timer / tile.maxTime, 0.0f, 1.0f);
-                if (timeRatio < 0.4f) {
-                    color = glm::mix(glm::vec4(0.0f, 1.0f, 0.2f, 1.0f),
-                        glm::vec4(1.0f, 1.0f, 0.2f, 1.0f),
-                        timeRatio * 2.5f);
-                }
-                else {
-                    color = glm::mix(glm::vec4(1.0f, 1.0f, 0.2f, 1.0f),
-                        glm::vec4(1.0f, 0.0f, 0.0f, 1.0f),
-                        (timeRatio - 0.4f) * 1.666f);
-                }
-            }
-
-            // Miganie gdy blisko zniknicia
-            if (tile.timer > tile.maxTime * 0.8f) {
-                float flash = sin(tile.timer * 15.0f) * 0.3f + 0.7f;
-                color *= flash;
-            }
-
-            shader.setVec4("objectColor", color);
-            shader.setMat4("model", model);
-            tileModel->Draw(shader);
-        }
-
-        shader.setVec4("objectColor", glm::vec4(1.0f));
-    }
+    // buffer - bufor instancji mostu na GPU, aktualizowany tylko w zmienionych miejscach
+    void Submit(RenderQueue& queue, Model& tileModel, InstanceBuffer& buffer);
 
     //Funkcja zwracajca aktualny wiatr
     glm::vec2 GetWindForce() const {
         return windVelocity;
     }
 
-    //Lista pozycji do generowania czsteczek (caa platforma)
-    std::vector<glm::vec3> GetParticleSpawnPoints() const {
-        std::vector<glm::vec3> points;
-        for (const auto& tile : tiles) {
-            if (tile.active && !tile.isEndTile) { // Nie generuj na kafelkach mety
-                points.push_back(tile.position);
-            }
-        }
-        return points;
-    }
-
     bool IsPlayerFalling(const glm::vec3& playerPos) {
         return (isPlayerOnBridge && playerPos.y < bridgeBounds.topY - 8.0f);
     }
+
+private:
+    static float TimerAt(const WindyTile& tile, float clock) {
+        return glm::max(0.0f, tile.timer - (clock - tile.stamp) * DECAY_RATE);
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <vector>
+#include <string>
+#include <glm/glm.hpp>
+#include "Hitbox.h"
+#include "Physics.h"
+#include "ColliderGrid.h"
+#include "WinZone.h"
+#include "Ladder.h"
+#include "Maze.h"
+#include "GlassBridge.h"
+#include "Trampoline.h"
+#include "BallManager.h"
+#include "MovingWallCourse.h"
+#include "WindyTileBridge.h"
+#include "FinalWinZone.h"
+
+enum GameState { GAME_STATE_MENU, GAME_STATE_PLAYING, GAME_STATE_CRASHED };
+
+struct MovingPlatform {
+    TableHitbox hitbox;
+    glm::vec3 startPos, endPos;
+    float speed, progress;
+    int direction;
+    glm::vec3 currentOffset;
+    int colliderId = -1;
+};
+
+// Stan klawiszy dla jednego kroku symulacji (wypełniany z GLFW albo ze skryptu)
+struct SimInput {
+    bool forward = false;
+    bool back = false;
+    bool left = false;
+    bool right = false;
+    bool jump = false;
+    bool sprint = false;
+    bool start = false;      // ENTER
+    float cameraYaw = -90.0f; // kierunek ruchu liczony względem kamery
+};
+
+// Pozycje rzeczy ruchomych zapamiętane po kroku symulacji - do interpolacji przy rysowaniu
+struct RenderState {
+    glm::vec3 eggPosition = glm::vec3(0.0f);
+    std::vector<glm::vec3> platformPositions;
+    std::vector<float> wallZ;
+};
+
+// Cała logika gry bez GLFW i OpenGL - rysowanie zostaje w main.cpp
+class World {
+public:
+    GameState currentState = GAME_STATE_MENU;
+
+    //OG SCIEZKA NIE USUWAC
+    glm::vec3 eggPosition = glm::vec3(0.0f, 0.7f, 5.0f);
+    //glm::vec3 eggPosition = glm::vec3(23.0f, 15.8f, 25.0f);
+    //glm::vec3 eggPosition = glm::vec3(-46.0f, 24.3f, 57.0f);
+    glm::vec3 previousEggPosition = eggPosition;
+    Physics physics;
+
+    float time = 0.0f; // czas symulacji (zamiast glfwGetTime)
+    float maxFallHeight = 0.7f;
+    int crackCount = 0;
+    float crashStartTime = 0.0f;
+
+    bool needsReset = false;
+    bool enterKeyPressed = false;
+    bool gameWon = false;
+    bool showWinMessage = false;
+    std::string winMessage = "";
+    float winMessageDisplayTime = 0.0f;
+    bool restrictMovementToWinZone = false; // Ograniczenie ruchu po wygranej
+
+    static constexpr int MAX_CRACKS = 3;
+
+    // Ile razy dzielimy jeden krok fizyki (szybkie spadanie / trampolina nie przelatuje przez cienkie blaty)
+    int substeps = 4;
+
+    // Stan z przedostatniego i ostatniego kroku
+    RenderState previousRenderState;
+    RenderState currentRenderState;
+
+    std::vector<MovingPlatform> platforms;
+    std::vector<TableHitbox> tables;
+
+    TableHitbox midSafeZone;
+    TableHitbox mazeFloor;
+    TableHitbox ladderPillow;  // HITBOX PODUSZKI
+    TableHitbox barrierBack;   // Barierka TYLNA
+    TableHitbox barrierFront;  // Barierka PRZEDNIA
+
+    // Wszystkie blaty, podłogi, barierki, rampa i platformy
+    ColliderGrid colliders;
+
+    WinZone winZone;
+    Ladder ladder;
+    Maze maze;
+    GlassBridge glassBridge;
+    Trampoline trampoline;
+    MovingWallCourse wallCourse;
+    WindyTileBridge windyBridge;
+    FinalWinZone finalWinZone;
+    BallManager ballManager;
+
+    World();
+
+    // Jeden krok gry o długości dt (wewnątrz dzielony na substeps)
+    void Step(float dt, const SimInput& input);
+
+    // Stan do rysowania: alpha = 0 -> poprzedni krok, 1 -> ostatni krok
+    RenderState Interpolate(float alpha) const;
+
+private:
+    void BuildColliders();
+    void ResetRun();
+    bool ProcessInput(const SimInput& input); // false = w tym kroku bez ruchu
+    void MoveEgg(float dt, const SimInput& input);
+    void CaptureRenderState(RenderState& out) const;
+    void UpdatePlaying(float dt);
+    void Crash();
+    void ApplyFallDamage(float landingY);
+};
+
+#endif
@@ -0,0 +1,156 @@
+#include "AssetLoader.h"
+#include "Model.h"
+#include "AssetPath.h"
+
+#include <algorithm>
+
+AssetLoader::AssetLoader(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    for (int i = 0; i < threadCount; i++)
+        workers.emplace_back(&AssetLoader::workerLoop, this);
+}
+
+AssetLoader::~AssetLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    jobReady.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void AssetLoader::push(std::function<void()> job)
+{
+    jobs.push_back(std::move(job));
+    pending++;
+    total++;
+    jobReady.notify_one();
+}
+
+void AssetLoader::QueueModel(Model& model, const std::string& path)
+{
+    Model* target = &model;
+    std::lock_guard<std::mutex> lock(mutex);
+    push([this, target, path] {
+        Result result;
+        result.kind = RESULT_MODEL;
+        result.path = path;
+        result.model = target;
+        // Pliki i tak wczytuje kilka wątków naraz - jeden .obj nie dzieli się na kolejne
+        result.meshes = Model::Import(path, 1);
+
+        // Tekstury materiałów od razu do kolejki - dekodują się, zanim model trafi na GPU
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const MeshData& mesh : result.meshes)
+                for (int slot = 0; slot < TEXTURE_SLOT_COUNT; slot++)
+                    if (!mesh.textures[slot].empty())
+                        queueTextureLocked(Model::TexturePath(path, mesh.textures[slot]), true);
+        }
+        complete(std::move(result));
+    });
+}
+
+void AssetLoader::QueueTexture(const std::string& path, bool stream)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    queueTextureLocked(path, stream);
+}
+
+void AssetLoader::queueTextureLocked(const std::string& path, bool stream)
+{
+    // Strumieniowane tekstury wczytuje TextureManager w tle - tu nie ma na co czekać
+    if (stream && TextureManager::Instance().Streaming()) return;
+    // Ta sama tekstura z kilku modeli (albo z modelu i z main) dekodowana raz
+    if (!queuedTextures.insert(AssetPath::Hash(AssetPath::Normalize(path))).second) return;
+    push([this, path] {
+        Result result;
+        result.kind = RESULT_TEXTURE;
+        result.path = path;
+        result.image = DecodedImage::Decode(path);
+        complete(std::move(result));
+    });
+}
+
+void AssetLoader::QueueImage(DecodedImage& target, const std::string& path, bool flipVertically)
+{
+    DecodedImage* image = &target;
+    std::lock_guard<std::mutex> lock(mutex);
+    push([this, image, path, flipVertically] {
+        Result result;
+        result.kind = RESULT_IMAGE;
+        result.path = path;
+        result.imageTarget = image;
+        result.image = DecodedImage::Decode(path, flipVertically);
+        complete(std::move(result));
+    });
+}
+
+void AssetLoader::complete(Result&& result)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(std::move(result));
+        pending--;
+    }
+    resultReady.notify_one();
+}
+
+void AssetLoader::workerLoop()
+{
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+void AssetLoader::Finish(const ProgressCallback& progress)
+{
+    std::vector<Result> ready;
+    std::vector<Result> models;
+    int done = 0;
+
+    for (;;) {
+        int totalNow;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            resultReady.wait(lock, [this] { return !results.empty() || pending == 0; });
+            if (results.empty()) break; // pending == 0 i nic do wysłania
+            ready.swap(results);
+            totalNow = total;
+        }
+
+        // Wysyłanie na GPU już bez blokady - wątki w tym czasie dekodują dalej
+        for (Result& result : ready) {
+            if (result.kind == RESULT_MODEL) {
+                models.push_back(std::move(result));
+                continue;
+            }
+            if (result.kind == RESULT_TEXTURE)
+                TextureManager::Instance().Preload(result.path, result.image);
+            else
+                *result.imageTarget = std::move(result.image);
+
+            done++;
+            if (progress) progress(done, totalNow, result.path);
+        }
+        ready.clear();
+    }
+
+    for (Result& result : models) {
+        result.model->Build(result.path, result.meshes);
+        done++;
+        if (progress) progress(done, total, result.path);
+    }
+}
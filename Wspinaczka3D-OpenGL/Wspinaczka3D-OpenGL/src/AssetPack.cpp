@@ -0,0 +1,201 @@
+#include "AssetPack.h"
+#include "AssetPath.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const char MAGIC[4] = { 'W', 'P', 'A', 'K' };
+
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t fileCount;
+    uint32_t slotCount;   // potęga 2, co najmniej 2x fileCount
+    uint64_t tableOffset; // slotCount * Slot
+    uint64_t namesOffset;
+    uint64_t namesSize;
+};
+
+// Pole tablicy haszującej; nameLength == 0 = wolne
+struct Slot {
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+};
+
+uint64_t Align(uint64_t n, uint64_t alignment) { return (n + alignment - 1) / alignment * alignment; }
+
+void WriteBytes(std::ofstream& out, const void* data, size_t bytes) {
+    out.write(static_cast<const char*>(data), (std::streamsize)bytes);
+}
+
+void Pad(std::ofstream& out, uint64_t& position, uint64_t alignment) {
+    static const char zeros[AssetPack::ALIGNMENT] = {};
+    uint64_t padding = Align(position, alignment) - position;
+    WriteBytes(out, zeros, (size_t)padding);
+    position += padding;
+}
+
+}
+
+bool AssetPack::Open(const std::string& path) {
+    Close();
+    if (!file.Open(path)) return false;
+
+    PackHeader header;
+    bool valid = file.Size() >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, file.Data(), sizeof(header));
+        valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION
+            && header.slotCount > 0 && (header.slotCount & (header.slotCount - 1)) == 0
+            && header.fileCount <= header.slotCount
+            && header.tableOffset <= file.Size() && header.slotCount <= (file.Size() - header.tableOffset) / sizeof(Slot)
+            && header.namesOffset <= file.Size() && header.namesSize <= file.Size() - header.namesOffset;
+    }
+
+    // Raz przy otwarciu sprawdzamy każde pole - Find może już ufać przesunięciom
+    uint32_t used = 0;
+    for (uint32_t i = 0; valid && i < header.slotCount; i++) {
+        Slot slot;
+        std::memcpy(&slot, file.Data() + header.tableOffset + i * sizeof(Slot), sizeof(slot));
+        if (slot.nameLength == 0) continue;
+        used++;
+        valid = (uint64_t)slot.nameOffset + slot.nameLength <= header.namesSize
+            && slot.offset <= file.Size() && slot.size <= file.Size() - slot.offset;
+    }
+    if (!valid || used != header.fileCount) {
+        std::cout << "ERROR::ASSET_PACK::INVALID_FILE " << path << std::endl;
+        Close();
+        return false;
+    }
+
+    slots = file.Data() + header.tableOffset;
+    names = reinterpret_cast<const char*>(file.Data() + header.namesOffset);
+    slotCount = header.slotCount;
+    fileCount = header.fileCount;
+    return true;
+}
+
+void AssetPack::Close() {
+    file.Close();
+    slots = nullptr;
+    names = nullptr;
+    slotCount = 0;
+    fileCount = 0;
+}
+
+const unsigned char* AssetPack::Find(const std::string& path, size_t& size) const {
+    if (!slotCount) return nullptr;
+
+    std::string name = AssetPath::Normalize(path);
+    uint64_t hash = AssetPath::Hash(name);
+    for (uint32_t probe = 0, i = (uint32_t)hash & (slotCount - 1); probe < slotCount; probe++, i = (i + 1) & (slotCount - 1)) {
+        Slot slot;
+        std::memcpy(&slot, slots + i * sizeof(Slot), sizeof(slot));
+        if (slot.nameLength == 0) return nullptr;
+        if (slot.hash == hash && slot.nameLength == name.size()
+            && AssetPath::Equal(names + slot.nameOffset, name.data(), name.size())) {
+            // Pusty plik jak na dysku (MappedFile go nie otwiera) - brak widoku
+            if (slot.size == 0) return nullptr;
+            size = (size_t)slot.size;
+            return file.Data() + slot.offset;
+        }
+    }
+    return nullptr;
+}
+
+bool AssetPack::Write(const std::string& packPath, const std::vector<std::pair<std::string, std::string>>& files) {
+    uint32_t slotCount = 2;
+    while (slotCount < files.size() * 2) slotCount *= 2;
+    std::vector<Slot> table(slotCount);
+    std::memset(table.data(), 0, table.size() * sizeof(Slot));
+    std::string names;
+
+    // Najpierw do pliku tymczasowego - przerwany zapis nie zostawi połowy paczki
+    std::string tempPath = packPath + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cout << "ERROR::ASSET_PACK::CANNOT_WRITE " << tempPath << std::endl;
+        return false;
+    }
+
+    PackHeader header = {};
+    WriteBytes(out, &header, sizeof(header)); // uzupełniany na końcu
+    uint64_t position = sizeof(header);
+
+    bool ok = true;
+    std::vector<char> contents;
+    for (const auto& entry : files) {
+        std::string name = AssetPath::Normalize(entry.first);
+        uint64_t hash = AssetPath::Hash(name);
+        uint32_t i = (uint32_t)hash & (slotCount - 1);
+        while (table[i].nameLength != 0 && !(table[i].hash == hash && table[i].nameLength == name.size()
+            && AssetPath::Equal(names.data() + table[i].nameOffset, name.data(), name.size())))
+            i = (i + 1) & (slotCount - 1);
+        if (name.empty() || table[i].nameLength != 0) {
+            std::cout << "ERROR::ASSET_PACK::DUPLICATE_NAME " << entry.first << std::endl;
+            ok = false;
+            break;
+        }
+
+        std::ifstream in(entry.second, std::ios::binary | std::ios::ate);
+        if (!in) {
+            std::cout << "ERROR::ASSET_PACK::CANNOT_READ " << entry.second << std::endl;
+            ok = false;
+            break;
+        }
+        contents.resize((size_t)in.tellg());
+        in.seekg(0);
+        in.read(contents.data(), (std::streamsize)contents.size());
+        if (!in) {
+            std::cout << "ERROR::ASSET_PACK::CANNOT_READ " << entry.second << std::endl;
+            ok = false;
+            break;
+        }
+
+        Pad(out, position, ALIGNMENT);
+        table[i] = { hash, position, contents.size(), (uint32_t)names.size(), (uint32_t)name.size() };
+        names += name;
+        WriteBytes(out, contents.data(), contents.size());
+        position += contents.size();
+    }
+
+    if (ok) {
+        Pad(out, position, 8);
+        header.tableOffset = position;
+        WriteBytes(out, table.data(), table.size() * sizeof(Slot));
+        position += table.size() * sizeof(Slot);
+        header.namesOffset = position;
+        header.namesSize = names.size();
+        WriteBytes(out, names.data(), names.size());
+
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.fileCount = (uint32_t)files.size();
+        header.slotCount = slotCount;
+        out.seekp(0);
+        WriteBytes(out, &header, sizeof(header));
+    }
+
+    out.close();
+    if (!ok || !out) {
+        if (ok) std::cout << "ERROR::ASSET_PACK::CANNOT_WRITE " << tempPath << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    // Windows nie nadpisuje istniejącego pliku przy rename
+    std::remove(packPath.c_str());
+    if (std::rename(tempPath.c_str(), packPath.c_str()) != 0) {
+        std::cout << "ERROR::ASSET_PACK::CANNOT_WRITE " << packPath << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
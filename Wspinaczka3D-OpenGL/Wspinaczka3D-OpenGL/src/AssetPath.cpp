@@ -0,0 +1,53 @@
+#include "AssetPath.h"
+
+#include <vector>
+
+namespace {
+
+char Lower(char c) { return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c; }
+
+}
+
+namespace AssetPath {
+
+std::string Normalize(const std::string& path) {
+    // Składniki bez "." i pustych, ".." zjada poprzedni (o ile jest co zjeść)
+    std::vector<std::string> parts;
+    std::string part;
+    for (size_t i = 0; i <= path.size(); i++) {
+        char c = i < path.size() ? path[i] : '/';
+        if (c != '/' && c != '\\') {
+            part += c;
+            continue;
+        }
+        if (part == "..") {
+            if (!parts.empty() && parts.back() != "..") parts.pop_back();
+            else parts.push_back(part);
+        }
+        else if (!part.empty() && part != ".") {
+            parts.push_back(part);
+        }
+        part.clear();
+    }
+
+    std::string result = (!path.empty() && (path[0] == '/' || path[0] == '\\')) ? "/" : "";
+    for (size_t i = 0; i < parts.size(); i++) {
+        if (i) result += '/';
+        result += parts[i];
+    }
+    return result;
+}
+
+uint64_t Hash(const std::string& normalizedPath) {
+    std::string lower = normalizedPath;
+    for (char& c : lower) c = Lower(c);
+    return Fnv1a(lower.data(), lower.size());
+}
+
+bool Equal(const char* a, const char* b, size_t length) {
+    for (size_t i = 0; i < length; i++)
+        if (Lower(a[i]) != Lower(b[i])) return false;
+    return true;
+}
+
+}
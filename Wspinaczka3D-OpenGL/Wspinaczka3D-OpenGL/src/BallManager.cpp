@@ -2,10 +2,8 @@
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
-#include <glm/gtc/matrix_transform.hpp>
 
-BallManager::BallManager(Model* modelRef) {
-    ballModel = modelRef;
+BallManager::BallManager() {
     spawnTimer = 0.0f;
 
     spawnInterval = 3.0f;
@@ -73,23 +71,6 @@ void BallManager::Update(float deltaTime) {
     }
 }
 
-void BallManager::Draw(Shader& shader) {
-    shader.setInt("useTexture", 1);
-    shader.setVec4("objectColor", glm::vec4(1.0f));
-
-    for (const auto& ball : balls) {
-        if (!ball.active) continue;
-
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, ball.position);
-        model = glm::rotate(model, glm::radians(ball.rotationAngle), glm::vec3(0.0f, 0.0f, 1.0f));
-        model = glm::scale(model, glm::vec3(ballRadius));
-
-        shader.setMat4("model", model);
-        ballModel->Draw(shader);
-    }
-}
-
 bool BallManager::CheckCollision(glm::vec3 playerPos) {
     float playerRadius = 0.5f;
 
@@ -0,0 +1,20 @@
+#include "BallManager.h"
+#include "Model.h"
+#include "RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+void BallManager::Submit(RenderQueue& queue, Model& ballModel) {
+    std::vector<InstanceData> instances;
+    instances.reserve(balls.size());
+    for (const auto& ball : balls) {
+        if (!ball.active) continue;
+
+        glm::mat4 model = glm::mat4(1.0f);
+        model = glm::translate(model, ball.position);
+        model = glm::rotate(model, glm::radians(ball.rotationAngle), glm::vec3(0.0f, 0.0f, 1.0f));
+        model = glm::scale(model, glm::vec3(ballRadius));
+
+        instances.push_back({ model, glm::vec4(1.0f) });
+    }
+    queue.SubmitInstanced(ballModel, instances.data(), (int)instances.size(), DrawState());
+}
@@ -0,0 +1,102 @@
+#include "ColliderGrid.h"
+#include "Physics.h"
+#include <algorithm>
+#include <cmath>
+
+int ColliderGrid::Cell(float v) const {
+    return (int)std::floor(v / cellSize);
+}
+
+long long ColliderGrid::Key(int cx, int cz) {
+    return ((long long)cx << 32) ^ (unsigned int)cz;
+}
+
+ColliderGrid::CellRange ColliderGrid::RangeOf(const TableHitbox& b) const {
+    return { Cell(b.minX), Cell(b.maxX), Cell(b.minZ), Cell(b.maxZ) };
+}
+
+void ColliderGrid::Insert(int id, const CellRange& r) {
+    for (int x = r.x0; x <= r.x1; x++)
+        for (int z = r.z0; z <= r.z1; z++)
+            cells[Key(x, z)].push_back(id);
+}
+
+void ColliderGrid::Remove(int id, const CellRange& r) {
+    for (int x = r.x0; x <= r.x1; x++) {
+        for (int z = r.z0; z <= r.z1; z++) {
+            auto it = cells.find(Key(x, z));
+            if (it == cells.end()) continue;
+            auto& ids = it->second;
+            ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+        }
+    }
+}
+
+int ColliderGrid::Add(const Collider& c) {
+    int id = (int)colliders.size();
+    colliders.push_back(c);
+    ranges.push_back(RangeOf(c.box));
+    Insert(id, ranges[id]);
+    return id;
+}
+
+void ColliderGrid::MoveBox(int id, const TableHitbox& box) {
+    colliders[id].box = box;
+
+    // Przepinamy między komórkami tylko gdy platforma przekroczy granicę komórki
+    CellRange r = RangeOf(box);
+    const CellRange& old = ranges[id];
+    if (r.x0 != old.x0 || r.x1 != old.x1 || r.z0 != old.z0 || r.z1 != old.z1) {
+        Remove(id, old);
+        Insert(id, r);
+        ranges[id] = r;
+    }
+}
+
+const std::vector<int>* ColliderGrid::CellAt(const glm::vec3& pos) const {
+    auto it = cells.find(Key(Cell(pos.x), Cell(pos.z)));
+    return it == cells.end() ? nullptr : &it->second;
+}
+
+bool ColliderGrid::ResolveHorizontal(glm::vec3& pos, const glm::vec3& oldPos, float halfHeight) const {
+    const std::vector<int>* ids = CellAt(pos);
+    if (!ids) return false;
+
+    for (int id : *ids) {
+        const Collider& c = colliders[id];
+        if (!c.solidSides || pos.y <= c.sidesAboveY) continue;
+
+        // Jeśli jesteśmy nad obiektem, to nie jest to ściana
+        if (pos.y > c.SurfaceY(pos.x) + halfHeight - 0.05f) continue;
+
+        if (Physics::IsInsideXZ(pos, c.box)) {
+            pos.x = oldPos.x;
+            pos.z = oldPos.z;
+            return true;
+        }
+    }
+    return false;
+}
+
+const Collider* ColliderGrid::FindSupport(const glm::vec3& pos, float oldY, float velocityY,
+    float halfHeight, float& restY) const {
+    if (velocityY > 0.0f) return nullptr;
+
+    const std::vector<int>* ids = CellAt(pos);
+    if (!ids) return nullptr;
+
+    const Collider* best = nullptr;
+    for (int id : *ids) {
+        const Collider& c = colliders[id];
+        if (!c.landable || !Physics::IsInsideXZ(pos, c.box)) continue;
+
+        float rest = c.SurfaceY(pos.x) + halfHeight;
+        if (oldY >= rest - c.landFrom && pos.y <= rest + c.landTo) {
+            if (!best || rest > restY) {
+                best = &c;
+                restY = rest;
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,16 @@
+#include "FinalWinZone.h"
+#include "Model.h"
+#include "RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+void FinalWinZone::Submit(RenderQueue& queue, Model& platformModel) {
+    DrawState state;
+    state.color = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f); // Zielona
+    state.staticCaster = true;
+
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, glm::vec3(position.x, topY - 0.2f, position.z));
+    model = glm::scale(model, glm::vec3(width, 0.4f, height));
+
+    queue.Submit(platformModel, model, state);
+}
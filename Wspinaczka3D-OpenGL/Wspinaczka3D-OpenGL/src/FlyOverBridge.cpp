@@ -1,4 +1,5 @@
 #include "FlyoverBridge.h"
+#include "RenderQueue.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 FlyoverBridge::FlyoverBridge(glm::vec3 pos, glm::vec3 rot, glm::vec3 sc, Model* modelRef) {
@@ -8,10 +9,7 @@ FlyoverBridge::FlyoverBridge(glm::vec3 pos, glm::vec3 rot, glm::vec3 sc, Model*
     model = modelRef;
 }
 
-void FlyoverBridge::Draw(Shader& shader) {
-    shader.setInt("useTexture", 1);
-    shader.setVec4("objectColor", glm::vec4(1.0f));
-
+void FlyoverBridge::Submit(RenderQueue& queue) {
     glm::mat4 modelMatrix = glm::mat4(1.0f);
 
     // 1. Pozycja
@@ -25,6 +23,7 @@ void FlyoverBridge::Draw(Shader& shader) {
     // 3. Skala
     modelMatrix = glm::scale(modelMatrix, scale);
 
-    shader.setMat4("model", modelMatrix);
-    model->Draw(shader);
+    DrawState state;
+    state.staticCaster = true;
+    queue.Submit(*model, modelMatrix, state);
 }
\ No newline at end of file
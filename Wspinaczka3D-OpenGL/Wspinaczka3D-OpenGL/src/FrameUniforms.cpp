@@ -0,0 +1,30 @@
+#include "FrameUniforms.h"
+#include <glad/glad.h>
+
+void FrameUniforms::create() {
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    stride = ((long long)sizeof(FrameData) + alignment - 1) / alignment * alignment;
+
+    glGenBuffers(1, &UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, stride * VIEW_COUNT, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::Release() {
+    if (UBO) glDeleteBuffers(1, &UBO);
+    UBO = 0;
+    stride = 0;
+}
+
+void FrameUniforms::Upload(View view, const FrameData& data) {
+    if (!UBO) create();
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, stride * view, sizeof(FrameData), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::Bind(View view) const {
+    glBindBufferRange(GL_UNIFORM_BUFFER, BINDING, UBO, stride * view, sizeof(FrameData));
+}
@@ -1,10 +1,8 @@
 #include "GlassBridge.h"
-#include <glm/gtc/matrix_transform.hpp>
 #include <cstdlib> // rand
 
-GlassBridge::GlassBridge(glm::vec3 startPos, float height, Model* modelRef) {
+GlassBridge::GlassBridge(glm::vec3 startPos, float height) {
     yLevel = height;
-    tileModel = modelRef;
 
     float stepX = 2.0f;      // Odlego midzy rzdami
     float spreadZ = 0.9f;    // Odsunicie od rodka
@@ -48,24 +46,6 @@ void GlassBridge::updateHitbox(GlassTile& tile) {
     tile.maxZ = tile.position.z + 0.5f;
 }
 
-void GlassBridge::Draw(Shader& shader) {
-    shader.setInt("useTexture", 1);
-    // Pprzezroczysto dla szka
-    shader.setVec4("objectColor", glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
-
-    for (const auto& tile : tiles) {
-        if (!tile.isBroken) {
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, glm::vec3(tile.position.x, yLevel, tile.position.z));
-            shader.setMat4("model", model);
-            tileModel->Draw(shader);
-        }
-    }
-
-    // Reset koloru
-    shader.setVec4("objectColor", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-}
-
 bool GlassBridge::checkCollision(glm::vec3 playerPos, float& playerY, float& velocityY, float playerHalfHeight) {
     float footLevel = playerPos.y - playerHalfHeight;
 
@@ -0,0 +1,22 @@
+#include "GlassBridge.h"
+#include "Model.h"
+#include "RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+void GlassBridge::Submit(RenderQueue& queue, Model& tileModel) {
+    // Półprzezroczystość dla szkła
+    DrawState state;
+    state.color = glm::vec4(1.0f, 1.0f, 1.0f, 0.5f);
+    state.pass = PASS_TRANSPARENT;
+
+    std::vector<InstanceData> instances;
+    instances.reserve(tiles.size());
+    for (const auto& tile : tiles) {
+        if (!tile.isBroken) {
+            glm::mat4 model = glm::mat4(1.0f);
+            model = glm::translate(model, glm::vec3(tile.position.x, yLevel, tile.position.z));
+            instances.push_back({ model, glm::vec4(1.0f) });
+        }
+    }
+    queue.SubmitInstanced(tileModel, instances.data(), (int)instances.size(), state);
+}
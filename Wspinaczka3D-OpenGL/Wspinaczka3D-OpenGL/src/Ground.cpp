@@ -1,7 +1,5 @@
 #include "Ground.h"
-#include <iostream>
-
-#include "stb_image.h"
+#include "RenderQueue.h"
 
 Ground::Ground(const std::string& texturePath, float size, float tiling, float y)
     : size(size), tiling(tiling), y(y)
@@ -42,59 +40,14 @@ Ground::Ground(const std::string& texturePath, float size, float tiling, float y
 
     glBindVertexArray(0);
 
-    textureID = loadTexture2D(texturePath);
+    texture = TextureManager::Instance().Load(texturePath);
 }
 
-unsigned int Ground::loadTexture2D(const std::string& path)
+void Ground::Submit(RenderQueue& queue)
 {
-    unsigned int tex;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-
-    // tiling
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-    // filtrowanie
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    int w, h, channels;
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char* data = stbi_load(path.c_str(), &w, &h, &channels, 0);
-
-    if (!data) {
-        std::cout << "Failed to load ground texture: " << path << "\n";
-        return tex;
-    }
-
-    GLenum format = GL_RGB;
-    if (channels == 1) format = GL_RED;
-    else if (channels == 3) format = GL_RGB;
-    else if (channels == 4) format = GL_RGBA;
-
-    glTexImage2D(GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    stbi_image_free(data);
-    return tex;
-}
-
-void Ground::Draw(Shader& shader)
-{
-    
-    shader.setInt("useTexture", 1);
-
-   
-    shader.setInt("texture_diffuse1", 0);
-
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-
-    
-    shader.setMat4("model", glm::mat4(1.0f));
-
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
+    DrawState state;
+    state.staticCaster = true;
+    queue.SubmitRaw(VAO, texture.Id(), glm::mat4(1.0f), state, [] {
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    });
 }
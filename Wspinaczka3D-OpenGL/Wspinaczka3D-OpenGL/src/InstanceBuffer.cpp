@@ -0,0 +1,53 @@
+#include "InstanceBuffer.h"
+#include <glad/glad.h>
+
+void InstanceBuffer::Release() {
+    if (VBO) glDeleteBuffers(1, &VBO);
+    VBO = 0;
+    capacity = 0;
+}
+
+void InstanceBuffer::Upload(const InstanceData* data, int count) {
+    if (!VBO) glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+    if (count > capacity) {
+        capacity = count;
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(InstanceData), data, GL_DYNAMIC_DRAW);
+    }
+    else {
+        // Osierocenie starego bufora - GPU może jeszcze czytać poprzednią klatkę
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(InstanceData), nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(InstanceData), data);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBuffer::UploadRange(const InstanceData* data, int first, int count) {
+    if (!VBO || count <= 0) return;
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(InstanceData), count * sizeof(InstanceData), data + first);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void PositionBuffer::Release() {
+    if (VBO) glDeleteBuffers(1, &VBO);
+    VBO = 0;
+    capacity = 0;
+}
+
+void PositionBuffer::Upload(const glm::vec3* data, int count) {
+    if (!VBO) glGenBuffers(1, &VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+    if (count > capacity) {
+        capacity = count;
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(glm::vec3), data, GL_STREAM_DRAW);
+    }
+    else {
+        // Osierocenie jak w InstanceBuffer::Upload
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(glm::vec3), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(glm::vec3), data);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
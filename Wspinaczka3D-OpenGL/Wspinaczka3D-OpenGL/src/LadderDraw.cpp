@@ -0,0 +1,25 @@
+#include "Ladder.h"
+#include "Model.h"
+#include "RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+void Ladder::Submit(RenderQueue& queue, Model& model) {
+    DrawState state;
+    state.useTexture = false;
+    state.color = glm::vec4(0.45f, 0.25f, 0.05f, 1.0f);
+    state.staticCaster = true;
+
+    // Segment 1 (Dół)
+    glm::mat4 modelMat = glm::mat4(1.0f);
+    modelMat = glm::translate(modelMat, position);
+    modelMat = glm::rotate(modelMat, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    modelMat = glm::scale(modelMat, glm::vec3(1.5f));
+    queue.Submit(model, modelMat, state);
+
+    // Segment 2 (Góra)
+    glm::mat4 modelMat2 = glm::mat4(1.0f);
+    modelMat2 = glm::translate(modelMat2, position + glm::vec3(0.0f, SEGMENT_HEIGHT, 0.0f));
+    modelMat2 = glm::rotate(modelMat2, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    modelMat2 = glm::scale(modelMat2, glm::vec3(1.5f));
+    queue.Submit(model, modelMat2, state);
+}
@@ -0,0 +1,53 @@
+#include "Material.h"
+#include "Shader.h"
+#include <glad/glad.h>
+
+namespace {
+    const int SLOT_UNITS[TEXTURE_SLOT_COUNT] = { 0, 1, 2, 4 };
+    const char* const SLOT_SAMPLERS[TEXTURE_SLOT_COUNT] = {
+        "texture_diffuse1",
+        "texture_metalness1",
+        "texture_roughness1",
+        "texture_normal1"
+    };
+}
+
+int Material::Unit(TextureSlot slot) { return SLOT_UNITS[slot]; }
+
+const char* Material::SamplerName(TextureSlot slot) { return SLOT_SAMPLERS[slot]; }
+
+bool Material::operator==(const Material& other) const {
+    for (int i = 0; i < TEXTURE_SLOT_COUNT; i++)
+        if (textures[i] != other.textures[i]) return false;
+    return true;
+}
+
+bool Material::operator<(const Material& other) const {
+    for (int i = 0; i < TEXTURE_SLOT_COUNT; i++)
+        if (textures[i] != other.textures[i]) return textures[i] < other.textures[i];
+    return false;
+}
+
+void Material::Bind(unsigned int slotMask) const {
+    bool otherUnits = false;
+    for (int i = 0; i < TEXTURE_SLOT_COUNT; i++) {
+        if (!(slotMask & (1u << i)) || textures[i] == 0) continue;
+        glActiveTexture(GL_TEXTURE0 + SLOT_UNITS[i]);
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+        otherUnits = otherUnits || SLOT_UNITS[i] != 0;
+    }
+    // reszta kodu podpina pojedyncze tekstury na jednostce 0
+    if (otherUnits) glActiveTexture(GL_TEXTURE0);
+}
+
+unsigned int Material::ResolveSamplers(Shader& shader) {
+    unsigned int mask = 0;
+    shader.use();
+    for (int i = 0; i < TEXTURE_SLOT_COUNT; i++) {
+        UniformHandle sampler = shader.uniform(SLOT_SAMPLERS[i]);
+        if (sampler < 0) continue;
+        shader.set(sampler, SLOT_UNITS[i]);
+        mask |= 1u << i;
+    }
+    return mask;
+}
@@ -0,0 +1,230 @@
+#include "Maze.h"
+#include "Mesh.h"
+#include "RenderQueue.h"
+#include "TextureManager.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+// Prostokąt (4 wierzchołki, 2 trójkąty) - a, b, c, d w kolejności przeciwnej do wskazówek zegara patrząc od strony normalnej
+static void AddQuad(std::vector<Vertex>& v, std::vector<unsigned int>& idx,
+    glm::vec3 a, glm::vec3 b, glm::vec3 c, glm::vec3 d, glm::vec3 n, glm::vec2 uvSize)
+{
+    unsigned int base = (unsigned int)v.size();
+    v.push_back({ a, n, {0.0f, 0.0f} });
+    v.push_back({ b, n, {uvSize.x, 0.0f} });
+    v.push_back({ c, n, {uvSize.x, uvSize.y} });
+    v.push_back({ d, n, {0.0f, uvSize.y} });
+    unsigned int q[6] = { 0, 1, 2, 2, 3, 0 };
+    for (unsigned int i : q) idx.push_back(base + i);
+}
+
+// Ściany labiryntu w jednej siatce w przestrzeni świata: połączone prostokąty,
+// bez dolnych ścianek (stoją na podłodze) i bez boków stykających się z inną ścianą
+static Mesh* BakeWalls(const Maze& maze)
+{
+    std::vector<Vertex> v;
+    std::vector<unsigned int> idx;
+
+    float bs = maze.blockSize;
+    float y0 = maze.startPosition.y;
+    float y1 = y0 + maze.wallHeight;
+    float h = maze.wallHeight / bs;
+    // Lewa / przednia krawędź pola (col,row) - środek pola to startPosition + col*blockSize
+    auto edgeX = [&](int col) { return maze.startPosition.x + col * bs - bs * 0.5f; };
+    auto edgeZ = [&](int row) { return maze.startPosition.z + row * bs - bs * 0.5f; };
+
+    for (const Maze::WallBox& b : maze.MergeWalls()) {
+        float x0 = edgeX(b.col), x1 = edgeX(b.col + b.width);
+        float z0 = edgeZ(b.row), z1 = edgeZ(b.row + b.depth);
+
+        // Góra
+        AddQuad(v, idx, { x0, y1, z1 }, { x1, y1, z1 }, { x1, y1, z0 }, { x0, y1, z0 },
+            { 0, 1, 0 }, { (float)b.width, (float)b.depth });
+
+        // Boki - tylko odcinki, za którymi nie ma ściany (sąsiednie odsłonięte pola łączymy)
+        for (int side = 0; side < 4; ++side) {
+            bool alongZ = (side < 2); // boki -X/+X biegną wzdłuż Z
+            int count = alongZ ? b.depth : b.width;
+            for (int i = 0; i < count; ) {
+                auto exposed = [&](int k) {
+                    if (side == 0) return !maze.IsWall(b.col - 1, b.row + k);
+                    if (side == 1) return !maze.IsWall(b.col + b.width, b.row + k);
+                    if (side == 2) return !maze.IsWall(b.col + k, b.row - 1);
+                    return !maze.IsWall(b.col + k, b.row + b.depth);
+                };
+                if (!exposed(i)) { i++; continue; }
+                int j = i;
+                while (j < count && exposed(j)) j++;
+
+                float len = (float)(j - i);
+                if (side == 0) {
+                    float za = edgeZ(b.row + i), zb = edgeZ(b.row + j);
+                    AddQuad(v, idx, { x0, y0, za }, { x0, y0, zb }, { x0, y1, zb }, { x0, y1, za }, { -1, 0, 0 }, { len, h });
+                }
+                else if (side == 1) {
+                    float za = edgeZ(b.row + i), zb = edgeZ(b.row + j);
+                    AddQuad(v, idx, { x1, y0, zb }, { x1, y0, za }, { x1, y1, za }, { x1, y1, zb }, { 1, 0, 0 }, { len, h });
+                }
+                else if (side == 2) {
+                    float xa = edgeX(b.col + i), xb = edgeX(b.col + j);
+                    AddQuad(v, idx, { xb, y0, z0 }, { xa, y0, z0 }, { xa, y1, z0 }, { xb, y1, z0 }, { 0, 0, -1 }, { len, h });
+                }
+                else {
+                    float xa = edgeX(b.col + i), xb = edgeX(b.col + j);
+                    AddQuad(v, idx, { xa, y0, z1 }, { xb, y0, z1 }, { xb, y1, z1 }, { xa, y1, z1 }, { 0, 0, 1 }, { len, h });
+                }
+                i = j;
+            }
+        }
+    }
+
+    if (v.empty()) return nullptr;
+    return new Mesh(v, idx, Material());
+}
+
+void Maze::InitGraphics()
+{
+    // 1. TWORZENIE GEOMETRII SZEŚCIANU
+    std::vector<Vertex> vertices = {
+        // Tył
+        {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f}},
+        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {1.0f, 1.0f}},
+        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {1.0f, 1.0f}},
+        {{-0.5f,  0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f}},
+        {{-0.5f, -0.5f, -0.5f}, {0.0f, 0.0f, -1.0f}, {0.0f, 0.0f}},
+        // Przód
+        {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
+        {{-0.5f,  0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},
+        {{-0.5f, -0.5f,  0.5f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
+        // Lewo
+        {{-0.5f,  0.5f,  0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
+        {{-0.5f,  0.5f, -0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
+        {{-0.5f, -0.5f, -0.5f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
+        {{-0.5f, -0.5f, -0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
+        {{-0.5f, -0.5f,  0.5f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
+        {{-0.5f,  0.5f,  0.5f}, {-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
+        // Prawo
+        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
+        {{ 0.5f,  0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}},
+        // Dół
+        {{-0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 1.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 1.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
+        {{-0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
+        {{-0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 1.0f}},
+        // Góra
+        {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}},
+        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
+        {{-0.5f,  0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
+        {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f}}
+    };
+
+    std::vector<unsigned int> indices;
+    for (unsigned int i = 0; i < vertices.size(); i++) indices.push_back(i);
+    cubeMesh = new Mesh(vertices, indices, Material());
+
+    // Ściany się nie ruszają - pieczemy je raz
+    wallMesh = BakeWalls(*this);
+
+    // --- TEXTURy 
+    wallTextureID = TextureManager::Instance().Acquire("assets/textures/maze_wall.png");   // np. cegła/kamień
+    floorTextureID = TextureManager::Instance().Acquire("assets/textures/maze_floor.png");  // np. płytki/kamień
+
+    // --- FLOOR MESH 
+    float halfW = mazeWidth * 0.5f;
+    float halfD = mazeDepth * 0.5f;
+
+    float topY = 0.0f;
+    float botY = -floorThickness;
+
+    float tileTop = 10.0f;   // tiling na górze
+    float tileSide = 2.0f;   // tiling na bokach 
+
+    std::vector<Vertex> v;
+
+    // --- TOP (normal up) ---
+    v.push_back({ {-halfW, topY, -halfD}, {0,1,0}, {0,0} });
+    v.push_back({ { halfW, topY, -halfD}, {0,1,0}, {tileTop,0} });
+    v.push_back({ { halfW, topY,  halfD}, {0,1,0}, {tileTop,tileTop} });
+    v.push_back({ { halfW, topY,  halfD}, {0,1,0}, {tileTop,tileTop} });
+    v.push_back({ {-halfW, topY,  halfD}, {0,1,0}, {0,tileTop} });
+    v.push_back({ {-halfW, topY, -halfD}, {0,1,0}, {0,0} });
+
+    // --- BOTTOM (normal down) ---
+    v.push_back({ {-halfW, botY,  halfD}, {0,-1,0}, {0,0} });
+    v.push_back({ { halfW, botY,  halfD}, {0,-1,0}, {tileTop,0} });
+    v.push_back({ { halfW, botY, -halfD}, {0,-1,0}, {tileTop,tileTop} });
+    v.push_back({ { halfW, botY, -halfD}, {0,-1,0}, {tileTop,tileTop} });
+    v.push_back({ {-halfW, botY, -halfD}, {0,-1,0}, {0,tileTop} });
+    v.push_back({ {-halfW, botY,  halfD}, {0,-1,0}, {0,0} });
+
+    // --- SIDE +Z (front) normal (0,0,1) ---
+    v.push_back({ {-halfW, botY,  halfD}, {0,0,1}, {0,0} });
+    v.push_back({ { halfW, botY,  halfD}, {0,0,1}, {tileSide,0} });
+    v.push_back({ { halfW, topY,  halfD}, {0,0,1}, {tileSide,1} });
+    v.push_back({ { halfW, topY,  halfD}, {0,0,1}, {tileSide,1} });
+    v.push_back({ {-halfW, topY,  halfD}, {0,0,1}, {0,1} });
+    v.push_back({ {-halfW, botY,  halfD}, {0,0,1}, {0,0} });
+
+    // --- SIDE -Z (back) normal (0,0,-1) ---
+    v.push_back({ { halfW, botY, -halfD}, {0,0,-1}, {0,0} });
+    v.push_back({ {-halfW, botY, -halfD}, {0,0,-1}, {tileSide,0} });
+    v.push_back({ {-halfW, topY, -halfD}, {0,0,-1}, {tileSide,1} });
+    v.push_back({ {-halfW, topY, -halfD}, {0,0,-1}, {tileSide,1} });
+    v.push_back({ { halfW, topY, -halfD}, {0,0,-1}, {0,1} });
+    v.push_back({ { halfW, botY, -halfD}, {0,0,-1}, {0,0} });
+
+    // --- SIDE +X (right) normal (1,0,0) ---
+    v.push_back({ { halfW, botY,  halfD}, {1,0,0}, {0,0} });
+    v.push_back({ { halfW, botY, -halfD}, {1,0,0}, {tileSide,0} });
+    v.push_back({ { halfW, topY, -halfD}, {1,0,0}, {tileSide,1} });
+    v.push_back({ { halfW, topY, -halfD}, {1,0,0}, {tileSide,1} });
+    v.push_back({ { halfW, topY,  halfD}, {1,0,0}, {0,1} });
+    v.push_back({ { halfW, botY,  halfD}, {1,0,0}, {0,0} });
+
+    // --- SIDE -X (left) normal (-1,0,0) ---
+    v.push_back({ {-halfW, botY, -halfD}, {-1,0,0}, {0,0} });
+    v.push_back({ {-halfW, botY,  halfD}, {-1,0,0}, {tileSide,0} });
+    v.push_back({ {-halfW, topY,  halfD}, {-1,0,0}, {tileSide,1} });
+    v.push_back({ {-halfW, topY,  halfD}, {-1,0,0}, {tileSide,1} });
+    v.push_back({ {-halfW, topY, -halfD}, {-1,0,0}, {0,1} });
+    v.push_back({ {-halfW, botY, -halfD}, {-1,0,0}, {0,0} });
+
+    std::vector<unsigned int> idx;
+    idx.reserve(v.size());
+    for (unsigned int i = 0; i < v.size(); i++) idx.push_back(i);
+
+    floorSlabMesh = new Mesh(v, idx, Material());
+}
+
+void Maze::SubmitFloor(RenderQueue& queue) {
+    float centerX = startPosition.x + (mazeWidth / 2.0f) - (blockSize / 2.0f);
+    float centerZ = startPosition.z + (mazeDepth / 2.0f) - (blockSize / 2.0f);
+
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, glm::vec3(centerX, startPosition.y, centerZ));
+    DrawState state;
+    state.staticCaster = true;
+    queue.Submit(*floorSlabMesh, model, state, floorTextureID);
+}
+
+
+void Maze::Submit(RenderQueue& queue) {
+    DrawState state;
+    state.useWorldUV = true;
+    state.texWorldSize = 2.0f; // testuj: 1.5 / 2 / 3
+    state.staticCaster = true;
+
+    // Siatka już w przestrzeni świata
+    if (wallMesh) queue.Submit(*wallMesh, glm::mat4(1.0f), state, wallTextureID);
+}
@@ -1,16 +1,39 @@
 #include "Mesh.h"
 #include "Shader.h"
+#include "InstanceBuffer.h"
 
-Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures)
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, const Material& material,
+    const std::vector<LodLevel>& lodChain)
 {
     this->vertices = vertices;
     this->indices = indices;
-    this->textures = textures;
+    this->material = material;
 
-    setupMesh();
+    ComputeBounds(this->vertices, bounds, sphere);
+    setupMesh(lodChain);
 }
 
-void Mesh::setupMesh()
+Mesh::Mesh(std::vector<Vertex>&& vertices, std::vector<unsigned int>&& indices, const Material& material,
+    const AABB& bounds, const BoundingSphere& sphere, const std::vector<LodLevel>& lodChain)
+    : vertices(std::move(vertices)), indices(std::move(indices)), material(material), bounds(bounds), sphere(sphere)
+{
+    setupMesh(lodChain);
+}
+
+void Mesh::ComputeBounds(const std::vector<Vertex>& vertices, AABB& bounds, BoundingSphere& sphere)
+{
+    bounds = AABB();
+    sphere = BoundingSphere();
+    for (const Vertex& v : vertices) bounds.Expand(v.Position);
+    if (bounds.Valid()) {
+        sphere.center = bounds.Center();
+        sphere.radius = 0.0f;
+        for (const Vertex& v : vertices)
+            sphere.radius = std::max(sphere.radius, glm::length(v.Position - sphere.center));
+    }
+}
+
+void Mesh::setupMesh(const std::vector<LodLevel>& lodChain)
 {
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -21,8 +44,22 @@ void Mesh::setupMesh()
 
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
 
+    // Wszystkie poziomy szczegółów jeden za drugim w tym samym EBO
+    lods.clear();
+    lods.push_back({ 0, (unsigned int)indices.size(), 0.0f });
+    unsigned int total = (unsigned int)indices.size();
+    for (const LodLevel& level : lodChain) {
+        lods.push_back({ total, (unsigned int)level.indices.size(), level.error });
+        total += (unsigned int)level.indices.size();
+    }
+
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, total * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices.size() * sizeof(unsigned int), &indices[0]);
+    for (size_t i = 0; i < lodChain.size(); i++) {
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, lods[i + 1].first * sizeof(unsigned int),
+            lodChain[i].indices.size() * sizeof(unsigned int), lodChain[i].indices.data());
+    }
 
     // pozycje
     glEnableVertexAttribArray(0);
@@ -39,25 +76,83 @@ void Mesh::setupMesh()
     glBindVertexArray(0);
 }
 
+// Samplery są już ustawione w programie - tylko tekstury, VAO i rysowanie
 void Mesh::Draw(Shader& shader)
 {
-    unsigned int diffuseNr = 1;
+    material.Bind(shader.materialSlots);
+    glBindVertexArray(VAO);
+    DrawBound();
+}
 
-    for (unsigned int i = 0; i < textures.size(); i++)
-    {
-        glActiveTexture(GL_TEXTURE0 + i);
+void Mesh::DrawBound(int lod) const
+{
+    const MeshLod& range = lods[lod];
+    glDrawElements(GL_TRIANGLES, range.count, GL_UNSIGNED_INT, (void*)(range.first * sizeof(unsigned int)));
+}
 
-        std::string name = textures[i].type;
+int Mesh::SelectLod(float distance, float scale, float pixelsPerUnit, float maxPixels) const
+{
+    // Błąd rośnie z poziomem - pierwszy od końca, który się mieści
+    float pixelsPerError = scale * pixelsPerUnit / std::max(distance, 0.001f);
+    for (int i = (int)lods.size() - 1; i > 0; i--) {
+        if (lods[i].error * pixelsPerError <= maxPixels) return i;
+    }
+    return 0;
+}
 
-        shader.setInt((name + std::to_string(diffuseNr)).c_str(), i);
-        glBindTexture(GL_TEXTURE_2D, textures[i].id);
+void Mesh::DrawInstanced(Shader& shader, unsigned int instanceVBO, int count)
+{
+    if (count <= 0) return;
+    material.Bind(shader.materialSlots);
+    glBindVertexArray(VAO);
+    DrawBoundInstanced(instanceVBO, count);
+}
 
-        if (name == "texture_diffuse")
-            diffuseNr++;
+void Mesh::DrawBoundInstanced(unsigned int instanceVBO, int count, int firstInstance, int lod) const
+{
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    size_t base = firstInstance * sizeof(InstanceData); // GL 3.3 nie ma baseInstance - przesunięte wskaźniki
+
+    // macierz model instancji (4 kolumny)
+    for (int i = 0; i < 4; i++) {
+        glEnableVertexAttribArray(3 + i);
+        glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            (void*)(base + offsetof(InstanceData, model) + i * sizeof(glm::vec4)));
+        glVertexAttribDivisor(3 + i, 1);
     }
 
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-    glActiveTexture(GL_TEXTURE0);
+    // kolor instancji
+    glEnableVertexAttribArray(7);
+    glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(base + offsetof(InstanceData, color)));
+    glVertexAttribDivisor(7, 1);
+
+    // macierz normalnych instancji (3 kolumny)
+    for (int i = 0; i < 3; i++) {
+        glEnableVertexAttribArray(8 + i);
+        glVertexAttribPointer(8 + i, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            (void*)(base + offsetof(InstanceData, normalMatrix) + i * sizeof(glm::vec3)));
+        glVertexAttribDivisor(8 + i, 1);
+    }
+
+    const MeshLod& range = lods[lod];
+    glDrawElementsInstanced(GL_TRIANGLES, range.count, GL_UNSIGNED_INT, (void*)(range.first * sizeof(unsigned int)), count);
+
+    // zwykłe Draw tego VAO nie może czytać z bufora instancji
+    for (int i = 3; i <= 10; i++) glDisableVertexAttribArray(i);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Mesh::DrawBoundAt(unsigned int positionVBO, int count, int lod) const
+{
+    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    glEnableVertexAttribArray(11);
+    glVertexAttribPointer(11, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glVertexAttribDivisor(11, 1);
+
+    const MeshLod& range = lods[lod];
+    glDrawElementsInstanced(GL_TRIANGLES, range.count, GL_UNSIGNED_INT, (void*)(range.first * sizeof(unsigned int)), count);
+
+    // wyłączony atrybut = stała (0, 0, 0) - inne rysowania nie są przesuwane
+    glDisableVertexAttribArray(11);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
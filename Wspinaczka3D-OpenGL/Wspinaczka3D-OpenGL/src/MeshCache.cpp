@@ -0,0 +1,226 @@
+#include "MeshCache.h"
+#include "Vfs.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const char MAGIC[4] = { 'W', 'M', 'S', 'H' };
+
+// Nagłówek pliku
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceHash;
+    uint32_t vertexSize;  // sizeof(Vertex) przy zapisie - inny układ = nieważny cache
+    uint32_t meshCount;
+};
+
+// Nagłówek siatki; za nim nazwy tekstur (każda wyrównana do 4 bajtów), wierzchołki, indeksy
+// i poziomy LOD (liczba indeksów, błąd, indeksy)
+struct MeshHeader {
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t lodCount;
+    uint32_t textureLength[TEXTURE_SLOT_COUNT];
+    float boundsMin[3], boundsMax[3];
+    float sphereCenter[3], sphereRadius;
+};
+
+struct LodHeader {
+    uint32_t indexCount;
+    float error;
+};
+
+size_t Align4(size_t n) { return (n + 3) & ~size_t(3); }
+
+// Indeks spoza wierzchołków = rysowanie czyta za końcem VBO
+bool IndicesInRange(const std::vector<unsigned int>& indices, uint32_t vertexCount) {
+    for (unsigned int index : indices)
+        if (index >= vertexCount) return false;
+    return true;
+}
+
+// Czytanie z zmapowanego pliku z kontrolą końca (ucięty plik = nieważny cache)
+class Reader {
+public:
+    Reader(const unsigned char* data, size_t size) : data(data), size(size) {}
+
+    const unsigned char* Take(size_t bytes) {
+        if (bytes > size - offset) return nullptr;
+        const unsigned char* p = data + offset;
+        offset += bytes;
+        return p;
+    }
+
+    template <typename T>
+    bool Read(T& value) {
+        const unsigned char* p = Take(sizeof(T));
+        if (!p) return false;
+        std::memcpy(&value, p, sizeof(T));
+        return true;
+    }
+
+    // Jedna kopia tablicy prosto z mapowania
+    template <typename T>
+    bool ReadArray(std::vector<T>& out, size_t count) {
+        if (count > (size - offset) / sizeof(T)) return false;
+        const unsigned char* p = Take(count * sizeof(T));
+        out.resize(count);
+        if (count) std::memcpy(out.data(), p, count * sizeof(T));
+        return true;
+    }
+
+    bool AtEnd() const { return offset == size; }
+
+private:
+    const unsigned char* data;
+    size_t size;
+    size_t offset = 0;
+};
+
+void Write(std::ofstream& out, const void* data, size_t bytes) {
+    out.write(static_cast<const char*>(data), (std::streamsize)bytes);
+}
+
+}
+
+namespace MeshCache {
+
+bool Load(const std::string& cachePath, uint64_t sourceHash, std::vector<MeshData>& meshes) {
+    FileView file = Vfs::Open(cachePath);
+    if (!file.Valid()) return false;
+
+    Reader in(file.Data(), file.Size());
+    FileHeader header;
+    if (!in.Read(header) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cout << "ERROR::MESH_CACHE::INVALID_FILE " << cachePath << std::endl;
+        return false;
+    }
+    // Nieaktualny cache to normalna sytuacja (zmieniony model) - po prostu import od nowa
+    if (header.version != VERSION || header.sourceHash != sourceHash || header.vertexSize != sizeof(Vertex))
+        return false;
+    if (header.meshCount > file.Size() / sizeof(MeshHeader)) {
+        std::cout << "ERROR::MESH_CACHE::INVALID_FILE " << cachePath << std::endl;
+        return false;
+    }
+
+    // Każde przerwanie pętli (też równo na granicy siatki) = uszkodzony plik
+    std::vector<MeshData> loaded(header.meshCount);
+    bool ok = true;
+    bool indicesValid = true;
+    for (MeshData& mesh : loaded) {
+        MeshHeader mh;
+        // Pusta siatka nie powstaje przy imporcie, a Mesh jej nie obsłuży
+        ok = in.Read(mh) && mh.vertexCount > 0 && mh.indexCount > 0;
+        for (int slot = 0; slot < TEXTURE_SLOT_COUNT && ok; slot++) {
+            const unsigned char* name = in.Take(Align4(mh.textureLength[slot]));
+            ok = name != nullptr;
+            if (ok) mesh.textures[slot].assign(reinterpret_cast<const char*>(name), mh.textureLength[slot]);
+        }
+        ok = ok && in.ReadArray(mesh.vertices, mh.vertexCount) && in.ReadArray(mesh.indices, mh.indexCount);
+        if (!ok) break;
+        indicesValid = IndicesInRange(mesh.indices, mh.vertexCount);
+        if (!indicesValid) break;
+
+        mesh.lods.resize(mh.lodCount);
+        for (LodLevel& lod : mesh.lods) {
+            LodHeader lh;
+            if (!in.Read(lh) || !in.ReadArray(lod.indices, lh.indexCount)) {
+                ok = false;
+                break;
+            }
+            indicesValid = IndicesInRange(lod.indices, mh.vertexCount);
+            if (!indicesValid) break;
+            lod.error = lh.error;
+        }
+        if (!ok || !indicesValid) break;
+
+        mesh.bounds = AABB(glm::vec3(mh.boundsMin[0], mh.boundsMin[1], mh.boundsMin[2]),
+            glm::vec3(mh.boundsMax[0], mh.boundsMax[1], mh.boundsMax[2]));
+        mesh.sphere.center = glm::vec3(mh.sphereCenter[0], mh.sphereCenter[1], mh.sphereCenter[2]);
+        mesh.sphere.radius = mh.sphereRadius;
+    }
+
+    if (!indicesValid) {
+        std::cout << "ERROR::MESH_CACHE::INVALID_FILE " << cachePath << std::endl;
+        return false;
+    }
+    if (!ok || !in.AtEnd()) {
+        std::cout << "ERROR::MESH_CACHE::TRUNCATED_FILE " << cachePath << std::endl;
+        return false;
+    }
+
+    meshes.swap(loaded);
+    return true;
+}
+
+bool Save(const std::string& cachePath, uint64_t sourceHash, const std::vector<MeshData>& meshes) {
+    // Najpierw do pliku tymczasowego - przerwany zapis nie zostawi połowy cache
+    std::string tempPath = cachePath + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cout << "ERROR::MESH_CACHE::CANNOT_WRITE " << tempPath << std::endl;
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.sourceHash = sourceHash;
+    header.vertexSize = sizeof(Vertex);
+    header.meshCount = (uint32_t)meshes.size();
+    Write(out, &header, sizeof(header));
+
+    const char padding[4] = {};
+    for (const MeshData& mesh : meshes) {
+        MeshHeader mh = {};
+        mh.vertexCount = (uint32_t)mesh.vertices.size();
+        mh.indexCount = (uint32_t)mesh.indices.size();
+        mh.lodCount = (uint32_t)mesh.lods.size();
+        for (int slot = 0; slot < TEXTURE_SLOT_COUNT; slot++)
+            mh.textureLength[slot] = (uint32_t)mesh.textures[slot].size();
+        for (int i = 0; i < 3; i++) {
+            mh.boundsMin[i] = mesh.bounds.min[i];
+            mh.boundsMax[i] = mesh.bounds.max[i];
+            mh.sphereCenter[i] = mesh.sphere.center[i];
+        }
+        mh.sphereRadius = mesh.sphere.radius;
+        Write(out, &mh, sizeof(mh));
+
+        for (int slot = 0; slot < TEXTURE_SLOT_COUNT; slot++) {
+            const std::string& name = mesh.textures[slot];
+            Write(out, name.data(), name.size());
+            Write(out, padding, Align4(name.size()) - name.size());
+        }
+        Write(out, mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+        Write(out, mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int));
+
+        for (const LodLevel& lod : mesh.lods) {
+            LodHeader lh = { (uint32_t)lod.indices.size(), lod.error };
+            Write(out, &lh, sizeof(lh));
+            Write(out, lod.indices.data(), lod.indices.size() * sizeof(unsigned int));
+        }
+    }
+
+    out.close();
+    if (!out) {
+        std::cout << "ERROR::MESH_CACHE::CANNOT_WRITE " << tempPath << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    // Windows nie nadpisuje istniejącego pliku przy rename
+    std::remove(cachePath.c_str());
+    if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+        std::cout << "ERROR::MESH_CACHE::CANNOT_WRITE " << cachePath << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,274 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+// Symetryczna macierz 4x4 błędu kwadratowego + suma wag (do przeliczenia na odległość)
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+    double weight = 0;
+
+    void AddPlane(const glm::dvec3& n, double d, double w) {
+        a2 += w * n.x * n.x; ab += w * n.x * n.y; ac += w * n.x * n.z; ad += w * n.x * d;
+        b2 += w * n.y * n.y; bc += w * n.y * n.z; bd += w * n.y * d;
+        c2 += w * n.z * n.z; cd += w * n.z * d;
+        d2 += w * d * d;
+        weight += w;
+    }
+
+    Quadric& operator+=(const Quadric& q) {
+        a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+        b2 += q.b2; bc += q.bc; bd += q.bd;
+        c2 += q.c2; cd += q.cd;
+        d2 += q.d2;
+        weight += q.weight;
+        return *this;
+    }
+
+    // Suma kwadratów odległości od płaszczyzn (ważona)
+    double Eval(const glm::dvec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        double e = a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+            + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+            + c2 * z * z + 2 * cd * z
+            + d2;
+        return e > 0.0 ? e : 0.0;
+    }
+};
+
+struct Collapse {
+    double cost;
+    unsigned int from, to;
+    bool operator<(const Collapse& o) const { return cost < o.cost; }
+};
+
+struct PositionHash {
+    size_t operator()(const glm::vec3& p) const {
+        unsigned int h[3];
+        std::memcpy(h, &p, sizeof(h));
+        return (h[0] * 73856093u) ^ (h[1] * 19349663u) ^ (h[2] * 83492791u);
+    }
+};
+
+glm::dvec3 TriangleNormal(const glm::dvec3& a, const glm::dvec3& b, const glm::dvec3& c) {
+    return glm::cross(b - a, c - a);
+}
+
+}
+
+std::vector<unsigned int> SimplifyMesh(const std::vector<Vertex>& vertices,
+    const std::vector<unsigned int>& indices, size_t targetIndexCount, float* error) {
+    if (error) *error = 0.0f;
+    if (indices.size() <= targetIndexCount || vertices.empty()) return indices;
+
+    // 1. Sklejenie wierzchołków o tej samej pozycji - topologia liczy się tylko na nich
+    std::unordered_map<glm::vec3, unsigned int, PositionHash> unique;
+    std::vector<unsigned int> remap(vertices.size());
+    std::vector<glm::dvec3> positions;
+    std::vector<std::vector<unsigned int>> copies; // wierzchołki z atrybutami dla każdej pozycji
+    for (unsigned int i = 0; i < vertices.size(); i++) {
+        auto it = unique.find(vertices[i].Position);
+        if (it == unique.end()) {
+            it = unique.emplace(vertices[i].Position, (unsigned int)positions.size()).first;
+            positions.push_back(glm::dvec3(vertices[i].Position));
+            copies.emplace_back();
+        }
+        remap[i] = it->second;
+        copies[it->second].push_back(i);
+    }
+    size_t count = positions.size();
+
+    std::vector<glm::uvec3> triangles;
+    triangles.reserve(indices.size() / 3);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        glm::uvec3 t(remap[indices[i]], remap[indices[i + 1]], remap[indices[i + 2]]);
+        if (t.x != t.y && t.y != t.z && t.x != t.z) triangles.push_back(t);
+    }
+
+    // 2. Kwadryki z płaszczyzn trójkątów (waga = pole)
+    std::vector<Quadric> quadrics(count);
+    for (const glm::uvec3& t : triangles) {
+        glm::dvec3 n = TriangleNormal(positions[t.x], positions[t.y], positions[t.z]);
+        double len = glm::length(n);
+        if (len <= 0.0) continue;
+        n /= len;
+        double d = -glm::dot(n, positions[t.x]);
+        for (int k = 0; k < 3; k++) quadrics[t[k]].AddPlane(n, d, len * 0.5);
+    }
+
+    // 3. Brzegi (krawędź w jednym trójkącie) zostają nietknięte
+    std::vector<bool> locked(count, false);
+    {
+        std::unordered_map<unsigned long long, int> edges;
+        for (const glm::uvec3& t : triangles) {
+            for (int k = 0; k < 3; k++) {
+                unsigned int a = t[k], b = t[(k + 1) % 3];
+                if (a > b) std::swap(a, b);
+                edges[((unsigned long long)a << 32) | b]++;
+            }
+        }
+        for (const auto& e : edges) {
+            if (e.second != 1) continue;
+            locked[(unsigned int)(e.first >> 32)] = true;
+            locked[(unsigned int)(e.first & 0xFFFFFFFFu)] = true;
+        }
+    }
+
+    // 4. Przebiegi zwijania: najtańsze krawędzie, każdy wierzchołek najwyżej raz na przebieg
+    std::vector<unsigned int> parent(count);
+    for (unsigned int i = 0; i < count; i++) parent[i] = i;
+    auto find = [&](unsigned int v) {
+        while (parent[v] != v) v = parent[v] = parent[parent[v]];
+        return v;
+    };
+
+    size_t targetTriangles = targetIndexCount / 3;
+    double maxError = 0.0;
+    std::vector<std::vector<unsigned int>> adjacency(count);
+    std::vector<bool> touched(count);
+    std::vector<Collapse> candidates;
+
+    for (int pass = 0; pass < 100 && triangles.size() > targetTriangles; pass++) {
+        for (auto& a : adjacency) a.clear();
+        for (unsigned int i = 0; i < triangles.size(); i++)
+            for (int k = 0; k < 3; k++) adjacency[triangles[i][k]].push_back(i);
+
+        candidates.clear();
+        for (const glm::uvec3& t : triangles) {
+            for (int k = 0; k < 3; k++) {
+                unsigned int a = t[k], b = t[(k + 1) % 3];
+                if (a > b) continue; // każda krawędź raz (obie strony dzieli z sąsiadem)
+                Quadric q = quadrics[a];
+                q += quadrics[b];
+                if (!locked[a]) candidates.push_back({ q.Eval(positions[b]), a, b });
+                if (!locked[b]) candidates.push_back({ q.Eval(positions[a]), b, a });
+            }
+        }
+        if (candidates.empty()) break;
+        std::sort(candidates.begin(), candidates.end());
+
+        // Każde zwinięcie usuwa zwykle dwa trójkąty
+        size_t allowed = (triangles.size() - targetTriangles) / 2 + 1;
+        size_t collapsed = 0;
+        std::fill(touched.begin(), touched.end(), false);
+
+        for (const Collapse& c : candidates) {
+            if (collapsed >= allowed) break;
+            if (touched[c.from] || touched[c.to]) continue;
+
+            // Trójkąty wokół "from" nie mogą się odwrócić po przesunięciu go na "to"
+            bool flips = false;
+            for (unsigned int ti : adjacency[c.from]) {
+                const glm::uvec3& t = triangles[ti];
+                if (t.x == c.to || t.y == c.to || t.z == c.to) continue;
+                glm::dvec3 p[3], q[3];
+                for (int k = 0; k < 3; k++) {
+                    p[k] = positions[t[k]];
+                    q[k] = t[k] == c.from ? positions[c.to] : p[k];
+                }
+                glm::dvec3 before = TriangleNormal(p[0], p[1], p[2]);
+                glm::dvec3 after = TriangleNormal(q[0], q[1], q[2]);
+                double lb = glm::length(before), la = glm::length(after);
+                if (la <= 0.0 || (lb > 0.0 && glm::dot(before, after) < 0.2 * lb * la)) {
+                    flips = true;
+                    break;
+                }
+            }
+            if (flips) continue;
+
+            parent[c.from] = c.to;
+            quadrics[c.to] += quadrics[c.from];
+            double w = quadrics[c.to].weight;
+            if (w > 0.0) maxError = std::max(maxError, c.cost / w);
+
+            // Cały pierścień "from" zmienia kształt - zablokowany do następnego przebiegu
+            for (unsigned int ti : adjacency[c.from])
+                for (int k = 0; k < 3; k++) touched[triangles[ti][k]] = true;
+            collapsed++;
+        }
+        if (collapsed == 0) break;
+
+        // Przepisanie trójkątów, zdegenerowane znikają
+        size_t out = 0;
+        for (size_t i = 0; i < triangles.size(); i++) {
+            glm::uvec3 t(find(triangles[i].x), find(triangles[i].y), find(triangles[i].z));
+            if (t.x == t.y || t.y == t.z || t.x == t.z) continue;
+            triangles[out++] = t;
+        }
+        triangles.resize(out);
+    }
+
+    // 5. Z powrotem na wierzchołki z atrybutami: dla zwiniętego narożnika kopia celu
+    //    o najbliższej normalnej (potem UV) do narożnika, który zastępuje
+    auto pickCopy = [&](unsigned int original, unsigned int target) {
+        const Vertex& o = vertices[original];
+        unsigned int best = copies[target][0];
+        float bestScore = -1e30f;
+        for (unsigned int v : copies[target]) {
+            float score = glm::dot(o.Normal, vertices[v].Normal) * 16.0f
+                - glm::length(o.TexCoords - vertices[v].TexCoords);
+            if (score > bestScore) {
+                bestScore = score;
+                best = v;
+            }
+        }
+        return best;
+    };
+
+    std::vector<unsigned int> result;
+    result.reserve(triangles.size() * 3);
+    std::unordered_map<unsigned long long, unsigned int> cornerChoice; // (pozycja docelowa, oryginał) -> wierzchołek
+
+    // Trójkąty wynikowe w kolejności oryginału: każdy oryginalny trójkąt, który przetrwał, daje jeden
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        unsigned int corner[3];
+        glm::uvec3 t;
+        for (int k = 0; k < 3; k++) {
+            corner[k] = indices[i + k];
+            t[k] = find(remap[corner[k]]);
+        }
+        if (t.x == t.y || t.y == t.z || t.x == t.z) continue;
+        for (int k = 0; k < 3; k++) {
+            unsigned int v = corner[k];
+            if (remap[v] != t[k]) {
+                unsigned long long key = ((unsigned long long)t[k] << 32) | v;
+                auto it = cornerChoice.find(key);
+                if (it == cornerChoice.end()) it = cornerChoice.emplace(key, pickCopy(v, t[k])).first;
+                v = it->second;
+            }
+            result.push_back(v);
+        }
+    }
+
+    if (error) *error = (float)std::sqrt(maxError);
+    return result;
+}
+
+std::vector<LodLevel> BuildLodChain(const std::vector<Vertex>& vertices,
+    const std::vector<unsigned int>& indices, int maxLevels, size_t minTriangles) {
+    std::vector<LodLevel> chain;
+    const std::vector<unsigned int>* current = &indices;
+    float error = 0.0f;
+
+    for (int level = 0; level < maxLevels; level++) {
+        size_t target = current->size() / 6 * 3;
+        if (target / 3 < minTriangles) break;
+
+        float levelError = 0.0f;
+        std::vector<unsigned int> simplified = SimplifyMesh(vertices, *current, target, &levelError);
+        // Nie da się już sensownie zmniejszyć (np. same brzegi)
+        if (simplified.size() > current->size() * 4 / 5) break;
+
+        // Błąd liczony od poprzedniego poziomu - sumowany, żeby był górnym ograniczeniem względem oryginału
+        error += levelError;
+        chain.push_back({ std::move(simplified), error });
+        current = &chain.back().indices;
+    }
+    return chain;
+}
@@ -1,18 +1,79 @@
 #include "Model.h"
-#include "stb_image.h"
 
 #include <glad/glad.h>
 #include <iostream>
 #include <algorithm> 
 #include <cstring>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
 #include "Shader.h"
+#include "ObjLoader.h"
+#include "Vfs.h"
+#include "AssetPath.h"
+
+namespace {
+
+// Assimp czyta przez Vfs - model i jego .mtl mog lee w paczce zasobw
+class VfsIOStream : public Assimp::IOStream
+{
+public:
+    explicit VfsIOStream(FileView view) : view(std::move(view)) {}
+
+    size_t Read(void* buffer, size_t size, size_t count) override
+    {
+        if (size == 0) return 0;
+        size_t items = std::min(count, (view.Size() - position) / size);
+        std::memcpy(buffer, view.Data() + position, items * size);
+        position += items * size;
+        return items;
+    }
+
+    size_t Write(const void*, size_t, size_t) override { return 0; }
+
+    aiReturn Seek(size_t offset, aiOrigin origin) override
+    {
+        // Jak MemoryIOStream z Assimp: przy aiOrigin_END przesunicie liczone wstecz od koca
+        size_t target = origin == aiOrigin_SET ? offset
+            : origin == aiOrigin_CUR ? position + offset : view.Size() - offset;
+        if (target > view.Size()) return aiReturn_FAILURE;
+        position = target;
+        return aiReturn_SUCCESS;
+    }
+
+    size_t Tell() const override { return position; }
+    size_t FileSize() const override { return view.Size(); }
+    void Flush() override {}
+
+private:
+    FileView view;
+    size_t position = 0;
+};
+
+class VfsIOSystem : public Assimp::IOSystem
+{
+public:
+    bool Exists(const char* file) const override { return Vfs::Open(file).Valid(); }
+    char getOsSeparator() const override { return '/'; }
+
+    Assimp::IOStream* Open(const char* file, const char* mode) override
+    {
+        if (std::strchr(mode, 'w') || std::strchr(mode, 'a')) return nullptr;
+        FileView view = Vfs::Open(file);
+        return view.Valid() ? new VfsIOStream(std::move(view)) : nullptr;
+    }
+
+    void Close(Assimp::IOStream* stream) override { delete stream; }
+};
+
+}
 
 // =====================
 // Konstruktor modelu
 // =====================
 Model::Model(std::string const& path)
 {
-    loadModel(path);
+    std::vector<MeshData> data = Import(path);
+    Build(path, data);
 }
 
 void Model::Draw(Shader& shader)
@@ -23,13 +84,74 @@ void Model::Draw(Shader& shader)
     }
 }
 
+void Model::DrawInstanced(Shader& shader, const InstanceData* instances, int count)
+{
+    if (count <= 0) return;
+    DrawInstanced(shader, UploadInstances(instances, count), count);
+}
+
+const InstanceBuffer& Model::UploadInstances(const InstanceData* instances, int count)
+{
+    if (count > 0) instanceBuffer.Upload(instances, count);
+    return instanceBuffer;
+}
+
+void Model::DrawInstanced(Shader& shader, const InstanceBuffer& buffer, int count)
+{
+    if (count <= 0) return;
+    shader.setInt("useInstancing", 1);
+    for (auto& mesh : meshes)
+    {
+        mesh.DrawInstanced(shader, buffer.VBO, count);
+    }
+    shader.setInt("useInstancing", 0);
+}
+
 // =====================
 // Wczytywanie modelu
 // =====================
 
-void Model::loadModel(std::string const& path)
+std::vector<MeshData> Model::Import(std::string const& path, int threads)
+{
+    // Najpierw cache obok modelu - wany tylko dla tej samej zawartoci pliku rdowego
+    std::vector<MeshData> data;
+    std::string cachePath = path + ".meshcache";
+    FileView source = Vfs::Open(path);
+    uint64_t sourceHash = source.Valid() ? Fnv1a(source.Data(), source.Size()) : 0;
+    std::string extension = path.substr(std::min(path.size(), path.find_last_of('.')));
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    // Tekstury .obj pochodz z .mtl - jego zmiana te musi uniewani cache
+    if (source.Valid() && extension == ".obj")
+    {
+        for (const std::string& library : ObjLoader::MaterialLibraries(source.Data(), source.Size()))
+        {
+            FileView mtl = Vfs::Open(TexturePath(path, library));
+            if (mtl.Valid()) sourceHash = Fnv1a(mtl.Data(), mtl.Size(), sourceHash);
+        }
+    }
+
+    if (!source.Valid() || !MeshCache::Load(cachePath, sourceHash, data))
+    {
+        // .obj wasnym wielowtkowym parserem, reszta (i .obj, ktrego on nie przeczyta) przez Assimp
+        if (extension != ".obj" || !ObjLoader::Load(path, data, threads))
+        {
+            data.clear();
+            if (!importAssimp(path, data)) return data;
+        }
+
+        for (MeshData& mesh : data) finishMesh(mesh);
+
+        // Paczka jest tylko do odczytu - nowy cache trafi do niej przy nastpnym pakowaniu
+        if (source.Valid() && !source.Packed()) MeshCache::Save(cachePath, sourceHash, data);
+    }
+    return data;
+}
+
+bool Model::importAssimp(std::string const& path, std::vector<MeshData>& data)
 {
     Assimp::Importer importer;
+    importer.SetIOHandler(new VfsIOSystem()); // importer przejmuje obiekt
 
     const aiScene* scene = importer.ReadFile(
         path,
@@ -41,36 +163,88 @@ void Model::loadModel(std::string const& path)
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
     {
         std::cout << "ERROR::ASSIMP::" << importer.GetErrorString() << std::endl;
-        return;
+        return false;
     }
 
+    processNode(scene->mRootNode, scene, data);
+    return true;
+}
+
+void Model::finishMesh(MeshData& data)
+{
+    // Due siatki dostaj acuch uproszczonych wersji (te same wierzchoki, mniej trjktw)
+    if (data.indices.size() / 3 >= LOD_MIN_TRIANGLES)
+        data.lods = BuildLodChain(data.vertices, data.indices);
+
+    Mesh::ComputeBounds(data.vertices, data.bounds, data.sphere);
+}
+
+std::string Model::TexturePath(std::string const& modelPath, std::string const& filename)
+{
+    size_t slash = modelPath.find_last_of("/\\");
+    if (slash == std::string::npos) return filename;
+    return modelPath.substr(0, slash) + "/" + filename;
+}
+
+void Model::Build(std::string const& path, std::vector<MeshData>& data)
+{
     // Wycigamy folder cieki (np. "assets/models")
     directory = path.substr(0, path.find_last_of("/\\"));
 
-    processNode(scene->mRootNode, scene);
+    // Tekstury i bufory GPU - tak samo dla importu i cache; tablice przechodz do Mesh bez kopiowania
+    meshes.reserve(data.size());
+    for (MeshData& d : data)
+    {
+        Material material;
+        for (int slot = 0; slot < TEXTURE_SLOT_COUNT; slot++)
+        {
+            if (!d.textures[slot].empty())
+                material.textures[slot] = loadTexture(d.textures[slot]);
+        }
+        meshes.emplace_back(std::move(d.vertices), std::move(d.indices), material, d.bounds, d.sphere, d.lods);
+    }
+
+    for (const Mesh& m : meshes) bounds.Expand(m.bounds);
+
+    // Bd poziomu modelu = najgorszy z siatek (krtsze acuchy kocz si na swoim ostatnim poziomie)
+    size_t levels = 1;
+    for (const Mesh& m : meshes) levels = std::max(levels, m.lods.size());
+    lodErrors.assign(levels, 0.0f);
+    for (const Mesh& m : meshes)
+        for (size_t i = 0; i < levels; i++)
+            lodErrors[i] = std::max(lodErrors[i], m.lods[std::min(i, m.lods.size() - 1)].error);
+}
+
+int Model::SelectLod(float distance, float scale, float pixelsPerUnit, float maxPixels) const
+{
+    float pixelsPerError = scale * pixelsPerUnit / std::max(distance, 0.001f);
+    for (int i = (int)lodErrors.size() - 1; i > 0; i--) {
+        if (lodErrors[i] * pixelsPerError <= maxPixels) return i;
+    }
+    return 0;
 }
 
-void Model::processNode(aiNode* node, const aiScene* scene)
+void Model::processNode(aiNode* node, const aiScene* scene, std::vector<MeshData>& out)
 {
     // wszystkie meshe przypisane do tego noda
     for (unsigned int i = 0; i < node->mNumMeshes; i++)
     {
         aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        meshes.push_back(processMesh(mesh, scene));
+        out.push_back(processMesh(mesh, scene));
     }
 
     // rekurencyjnie przetwarzamy dzieci
     for (unsigned int i = 0; i < node->mNumChildren; i++)
     {
-        processNode(node->mChildren[i], scene);
+        processNode(node->mChildren[i], scene, out);
     }
 }
 
-Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
+MeshData Model::processMesh(aiMesh* mesh, const aiScene* scene)
 {
-    std::vector<Vertex>    vertices;
-    std::vector<unsigned int> indices;
-    std::vector<Texture>  textures;
+    MeshData data;
+    std::vector<Vertex>& vertices = data.vertices;
+    std::vector<unsigned int>& indices = data.indices;
 
     // ----- vertexy -----
     vertices.reserve(mesh->mNumVertices);
@@ -125,120 +299,56 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
         }
     }
 
-    // ----- tekstury -----
+    // ----- materia -----
+    // Eksport OBJ z Blendera zapisuje mapy PBR pod starymi nazwami MTL
+    // (map_refl = metalness, map_Ns = roughness, map_Bump = normal), wic kady slot ma zapasowy typ
     if (mesh->mMaterialIndex >= 0)
     {
-        aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
+        aiMaterial* mat = scene->mMaterials[mesh->mMaterialIndex];
 
-        // diffuse (kolor)
-        std::vector<Texture> diffuseMaps =
-            loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
-        textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
+        data.textures[TEXTURE_DIFFUSE] = materialTexturePath(mat, aiTextureType_DIFFUSE, aiTextureType_BASE_COLOR);
+        data.textures[TEXTURE_METALNESS] = materialTexturePath(mat, aiTextureType_METALNESS, aiTextureType_REFLECTION);
+        data.textures[TEXTURE_ROUGHNESS] = materialTexturePath(mat, aiTextureType_DIFFUSE_ROUGHNESS, aiTextureType_SHININESS);
+        data.textures[TEXTURE_NORMAL] = materialTexturePath(mat, aiTextureType_NORMALS, aiTextureType_HEIGHT);
     }
 
-    return Mesh(vertices, indices, textures);
+    return data;
 }
 
-std::vector<Texture> Model::loadMaterialTextures(aiMaterial* mat,
-    aiTextureType type,
-    std::string typeName)
+std::string Model::materialTexturePath(aiMaterial* mat, aiTextureType type, aiTextureType fallback)
 {
-    std::vector<Texture> textures;
-
-    for (unsigned int i = 0; i < mat->GetTextureCount(type); i++)
-    {
-        aiString str;
-        mat->GetTexture(type, i, &str);
+    if (mat->GetTextureCount(type) == 0)
+        type = fallback;
+    if (mat->GetTextureCount(type) == 0)
+        return "";
 
-        
-       
-        std::string filename = std::string(str.C_Str());
+    aiString str;
+    mat->GetTexture(type, 0, &str);
 
-        // 2. Zamieniamy backslashe '\\' na slashe '/'
-        std::replace(filename.begin(), filename.end(), '\\', '/');
+    std::string filename = std::string(str.C_Str());
 
-        
-        size_t lastSlash = filename.find_last_of("/");
-        if (lastSlash != std::string::npos) {
-            filename = filename.substr(lastSlash + 1);
-        }
-       
+    // 2. Zamieniamy backslashe '\\' na slashe '/'
+    std::replace(filename.begin(), filename.end(), '\\', '/');
 
-        bool skip = false;
-        for (unsigned int j = 0; j < textures_loaded.size(); j++)
-        {
-            if (std::strcmp(textures_loaded[j].path.data(), filename.c_str()) == 0)
-            {
-                textures.push_back(textures_loaded[j]);
-                skip = true;
-                break;
-            }
-        }
-
-        if (!skip)
-        {
-            Texture texture;
-            
-            texture.id = TextureFromFile(filename.c_str(), this->directory);
-            texture.type = typeName;
-            texture.path = filename; 
-            textures.push_back(texture);
-            textures_loaded.push_back(texture);
-        }
+    size_t lastSlash = filename.find_last_of("/");
+    if (lastSlash != std::string::npos) {
+        filename = filename.substr(lastSlash + 1);
     }
-
-    return textures;
+    return filename;
 }
 
-// =====================
-// adowanie tekstury z pliku
-// =====================
-
-unsigned int TextureFromFile(const char* path, const std::string& directory)
+unsigned int Model::loadTexture(const std::string& filename)
 {
-    std::string filename = std::string(path);
-    // jeli cieka w .mtl jest wzgldna, doklejamy katalog
-    if (!directory.empty())
-    {
-        filename = directory + "/" + filename;
-    }
+    std::string path = directory.empty() ? filename : directory + "/" + filename;
+    TextureHandle texture = TextureManager::Instance().Load(path);
+    if (!texture.Valid()) return 0;
 
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-
-    int width, height, nrComponents;
-    stbi_set_flip_vertically_on_load(true);
-
-    // adowanie pliku
-    unsigned char* data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        GLenum format = GL_RGB;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0,
-            format, width, height,
-            0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
+    // Jedna referencja na model wystarczy - wiele siatek z t sam tekstur jej nie zwiksza
+    unsigned int id = texture.Id();
+    for (const TextureHandle& held : textures)
     {
-        std::cout << "Failed to load texture at path: " << filename << std::endl;
-        stbi_image_free(data);
+        if (held.Id() == id) return id;
     }
-
-    return textureID;
-}
\ No newline at end of file
+    textures.push_back(std::move(texture));
+    return id;
+}
@@ -1,11 +1,7 @@
 ﻿#include "MovingWallCourse.h"
-#include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
 
-MovingWallCourse::MovingWallCourse(glm::vec3 pos,
-    unsigned int wallTex,
-    unsigned int floorTex,
-    Mesh* cube)
+MovingWallCourse::MovingWallCourse(glm::vec3 pos)
 {
     startPos = pos;
     roadLength = 30.0f;
@@ -29,10 +25,6 @@ MovingWallCourse::MovingWallCourse(glm::vec3 pos,
     roadHitbox.topY = startPos.y; // górna powierzchnia drogi
 
 
-    wallTexture = wallTex;
-    floorTexture = floorTex;
-    cubeMesh = cube;
-
     // 3 ściany
     for (int i = 0; i < 3; ++i) {
         Wall w;
@@ -40,9 +32,6 @@ MovingWallCourse::MovingWallCourse(glm::vec3 pos,
         w.phase = i * 1.5f;
         walls.push_back(w);
     }
-
-    // prosta płaska droga (użyjemy cubeMesh jako cienkiego boxa)
-    floorMesh = cubeMesh;
 }
 
 void MovingWallCourse::Update(float dt)
@@ -59,63 +48,6 @@ void MovingWallCourse::Update(float dt)
 
 
 
-void MovingWallCourse::Draw(Shader& shader)
-{
-    // --- ROAD ---
-    shader.setInt("useTexture", 1);
-    shader.setInt("useWorldUV", 0);
-
-    glBindTexture(GL_TEXTURE_2D, floorTexture);
-
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model,
-        glm::vec3(startPos.x, startPos.y - 0.1f, startPos.z + roadLength * 0.5f));
-    model = glm::scale(model, glm::vec3(roadWidth, 0.2f, roadLength));
-    shader.setMat4("model", model);
-    floorMesh->Draw(shader);
-
-    // --- WALLS ---
-    glBindTexture(GL_TEXTURE_2D, wallTexture);
-    shader.setInt("useWorldUV", 1);
-    shader.setFloat("texWorldSize", 2.0f);
-
-    float sidePillarWidth =
-        (wallWidth - 2.0f * holeWidth - midPillarWidth) * 0.5f;
-
-    for (const auto& w : walls)
-    {
-        // funkcja pomocnicza do rysowania jednego bloku
-        auto drawBlock = [&](float centerX, float widthX)
-            {
-                glm::mat4 m(1.0f);
-                m = glm::translate(m,
-                    glm::vec3(centerX,
-                        startPos.y + wallHeight * 0.5f,
-                        w.zPos));
-                m = glm::scale(m,
-                    glm::vec3(widthX, wallHeight, wallThickness));
-                shader.setMat4("model", m);
-                cubeMesh->Draw(shader);
-            };
-
-        float cx = startPos.x;
-
-        // LEWY FILAR
-        drawBlock(cx - (holeWidth + midPillarWidth * 0.5f + sidePillarWidth * 0.5f),
-            sidePillarWidth);
-
-        // ŚRODKOWY FILAR
-        drawBlock(cx, midPillarWidth);
-
-        // PRAWY FILAR
-        drawBlock(cx + (holeWidth + midPillarWidth * 0.5f + sidePillarWidth * 0.5f),
-            sidePillarWidth);
-    }
-
-    shader.setInt("useWorldUV", 0);
-}
-
-
 bool MovingWallCourse::CheckPlayer(const glm::vec3& p, float r)
 {
     // 1) działamy tylko na drodze
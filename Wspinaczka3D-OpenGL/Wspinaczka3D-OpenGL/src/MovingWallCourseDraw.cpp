@@ -0,0 +1,51 @@
+#include "MovingWallCourse.h"
+#include "Mesh.h"
+#include "RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+void MovingWallCourse::Submit(RenderQueue& queue, Mesh& cube, unsigned int wallTexture, unsigned int floorTexture, const std::vector<float>& wallZ)
+{
+    // --- ROAD ---
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model,
+        glm::vec3(startPos.x, startPos.y - 0.1f, startPos.z + roadLength * 0.5f));
+    model = glm::scale(model, glm::vec3(roadWidth, 0.2f, roadLength));
+    queue.Submit(cube, model, DrawState(), floorTexture);
+
+    // --- WALLS ---
+    DrawState wallState;
+    wallState.useWorldUV = true;
+    wallState.texWorldSize = 2.0f;
+
+    float sidePillarWidth =
+        (wallWidth - 2.0f * holeWidth - midPillarWidth) * 0.5f;
+
+    for (float zPos : wallZ)
+    {
+        // funkcja pomocnicza do rysowania jednego bloku
+        auto drawBlock = [&](float centerX, float widthX)
+            {
+                glm::mat4 m(1.0f);
+                m = glm::translate(m,
+                    glm::vec3(centerX,
+                        startPos.y + wallHeight * 0.5f,
+                        zPos));
+                m = glm::scale(m,
+                    glm::vec3(widthX, wallHeight, wallThickness));
+                queue.Submit(cube, m, wallState, wallTexture);
+            };
+
+        float cx = startPos.x;
+
+        // LEWY FILAR
+        drawBlock(cx - (holeWidth + midPillarWidth * 0.5f + sidePillarWidth * 0.5f),
+            sidePillarWidth);
+
+        // ŚRODKOWY FILAR
+        drawBlock(cx, midPillarWidth);
+
+        // PRAWY FILAR
+        drawBlock(cx + (holeWidth + midPillarWidth * 0.5f + sidePillarWidth * 0.5f),
+            sidePillarWidth);
+    }
+}
@@ -0,0 +1,521 @@
+#include "ObjLoader.h"
+#include "Vfs.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// Mniejsze kawałki nie opłacają się - start wątku kosztuje więcej niż ich parsowanie
+const size_t MIN_CHUNK_BYTES = 256 * 1024;
+
+// Narożnik trójkąta: indeksy od 0, -1 = brak UV / normalnej
+struct Corner {
+    int v, vt, vn;
+
+    bool operator==(const Corner& other) const { return v == other.v && vt == other.vt && vn == other.vn; }
+};
+
+struct CornerHash {
+    size_t operator()(const Corner& c) const {
+        uint64_t h = (uint32_t)c.v;
+        h = h * 0x100000001B3ull ^ (uint32_t)c.vt;
+        h = h * 0x100000001B3ull ^ (uint32_t)c.vn;
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return (size_t)h;
+    }
+};
+
+enum EventType { EVENT_OBJECT, EVENT_MATERIAL };
+
+// "o"/"g" albo "usemtl" - przed narożnikiem o numerze corner (w obrębie kawałka)
+struct Event {
+    size_t corner;
+    EventType type;
+    std::string name;
+};
+
+// Wynik parsowania jednego kawałka pliku. Indeksy ujemne (względne) są liczone od początku
+// kawałka i poprawiane, gdy wiadomo już, ile pozycji/UV/normalnych było w kawałkach przed nim.
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texcoords;
+    std::vector<glm::vec3> normals;
+    std::vector<Corner> corners; // po 3 na trójkąt
+    std::vector<Event> events;
+    std::vector<std::string> libraries; // mtllib
+    std::vector<size_t> relative;       // narożnik * 3 + składowa (0 = v, 1 = vt, 2 = vn)
+    bool error = false;
+};
+
+// Jedna siatka wyniku: ciągłe fragmenty narożników z kolejnych kawałków
+struct Part {
+    std::string material;
+    std::vector<std::pair<const Corner*, const Corner*>> ranges;
+    size_t cornerCount = 0;
+};
+
+// Mapy z .mtl: podstawowa nazwa i zapasowa (stare klucze, których używa eksport z Blendera) - jak w Model
+struct MaterialMaps {
+    std::string primary[TEXTURE_SLOT_COUNT];
+    std::string fallback[TEXTURE_SLOT_COUNT];
+};
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+inline bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+const char* SkipBlanks(const char* p, const char* end)
+{
+    while (p < end && IsBlank(*p)) p++;
+    return p;
+}
+
+// Słowo kluczowe na początku linii, a za nim odstęp albo koniec linii; rest = reszta linii
+bool Keyword(const char* p, const char* end, const char* word, const char*& rest)
+{
+    size_t length = std::strlen(word);
+    if ((size_t)(end - p) < length || std::memcmp(p, word, length) != 0) return false;
+    if (p + length < end && !IsBlank(p[length])) return false;
+    rest = p + length;
+    return true;
+}
+
+std::string Trimmed(const char* p, const char* end)
+{
+    p = SkipBlanks(p, end);
+    while (end > p && IsBlank(end[-1])) end--;
+    return std::string(p, end);
+}
+
+double Pow10(int n)
+{
+    static const double table[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    return n <= 22 ? table[n] : std::pow(10.0, n);
+}
+
+// Liczba zmiennoprzecinkowa bez locale (strtof zależy od ustawień regionalnych i jest wolny);
+// nullptr = nie ma tu liczby
+const char* ParseFloat(const char* p, const char* end, float& out)
+{
+    p = SkipBlanks(p, end);
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+    uint64_t mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool any = false;
+    for (; p < end && IsDigit(*p); p++, any = true) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa) digits++;
+        }
+        else {
+            exponent++;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && IsDigit(*p); p++, any = true) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa) digits++;
+                exponent--;
+            }
+        }
+    }
+    if (!any) return nullptr;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool negativeExp = false;
+        if (q < end && (*q == '-' || *q == '+')) negativeExp = *q++ == '-';
+        if (q < end && IsDigit(*q)) {
+            int e = 0;
+            for (; q < end && IsDigit(*q); q++) e = std::min(e * 10 + (*q - '0'), 1000);
+            exponent += negativeExp ? -e : e;
+            p = q;
+        }
+    }
+
+    double value = (double)mantissa;
+    value = exponent < 0 ? value / Pow10(-exponent) : value * Pow10(exponent);
+    out = (float)(negative ? -value : value);
+    return p;
+}
+
+const char* ParseInt(const char* p, const char* end, int& out)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+    if (p >= end || !IsDigit(*p)) return nullptr;
+    long long value = 0;
+    for (; p < end && IsDigit(*p); p++) value = std::min(value * 10 + (*p - '0'), 0x7FFFFFFFll);
+    out = (int)(negative ? -value : value);
+    return p;
+}
+
+int& Component(Corner& c, int component)
+{
+    return component == 0 ? c.v : component == 1 ? c.vt : c.vn;
+}
+
+// Indeks z pliku (od 1, ujemny = od końca) -> od 0; false dla 0
+bool ResolveIndex(int value, size_t count, int& out, bool& relative)
+{
+    if (value == 0) return false;
+    relative = value < 0;
+    out = relative ? (int)count + value : value - 1;
+    return true;
+}
+
+bool ParseFace(const char* p, const char* end, Chunk& chunk, std::vector<std::pair<Corner, int>>& face)
+{
+    face.clear();
+    for (;;) {
+        p = SkipBlanks(p, end);
+        if (p >= end) break;
+
+        Corner c = { -1, -1, -1 };
+        int relative = 0; // bit na składową
+        int value;
+        bool rel;
+        p = ParseInt(p, end, value);
+        if (!p || !ResolveIndex(value, chunk.positions.size(), c.v, rel)) return false;
+        if (rel) relative |= 1;
+
+        if (p < end && *p == '/') {
+            p++;
+            if (p < end && *p != '/') {
+                p = ParseInt(p, end, value);
+                if (!p || !ResolveIndex(value, chunk.texcoords.size(), c.vt, rel)) return false;
+                if (rel) relative |= 2;
+            }
+            if (p < end && *p == '/') {
+                p = ParseInt(p + 1, end, value);
+                if (!p || !ResolveIndex(value, chunk.normals.size(), c.vn, rel)) return false;
+                if (rel) relative |= 4;
+            }
+        }
+        if (p < end && !IsBlank(*p)) return false;
+        face.push_back({ c, relative });
+    }
+
+    // Wachlarz od pierwszego narożnika (ściany z eksportu są wypukłe); linie i punkty pomijane
+    for (size_t i = 1; i + 1 < face.size(); i++) {
+        const std::pair<Corner, int>* triangle[3] = { &face[0], &face[i], &face[i + 1] };
+        for (const auto* corner : triangle) {
+            for (int k = 0; k < 3; k++)
+                if (corner->second & (1 << k)) chunk.relative.push_back(chunk.corners.size() * 3 + k);
+            chunk.corners.push_back(corner->first);
+        }
+    }
+    return true;
+}
+
+void ParseChunk(Chunk& chunk)
+{
+    std::vector<std::pair<Corner, int>> face;
+    const char* p = chunk.begin;
+    while (p < chunk.end && !chunk.error) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', chunk.end - p));
+        if (!lineEnd) lineEnd = chunk.end;
+        const char* s = SkipBlanks(p, lineEnd);
+        const char* rest = nullptr;
+
+        if (Keyword(s, lineEnd, "v", rest)) {
+            glm::vec3 v;
+            chunk.error = !(rest = ParseFloat(rest, lineEnd, v.x)) || !(rest = ParseFloat(rest, lineEnd, v.y))
+                || !ParseFloat(rest, lineEnd, v.z);
+            chunk.positions.push_back(v);
+        }
+        else if (Keyword(s, lineEnd, "vt", rest)) {
+            glm::vec2 uv(0.0f);
+            chunk.error = !(rest = ParseFloat(rest, lineEnd, uv.x));
+            if (rest) ParseFloat(rest, lineEnd, uv.y); // samo U też się zdarza
+            chunk.texcoords.push_back(uv);
+        }
+        else if (Keyword(s, lineEnd, "vn", rest)) {
+            glm::vec3 n;
+            chunk.error = !(rest = ParseFloat(rest, lineEnd, n.x)) || !(rest = ParseFloat(rest, lineEnd, n.y))
+                || !ParseFloat(rest, lineEnd, n.z);
+            chunk.normals.push_back(n);
+        }
+        else if (Keyword(s, lineEnd, "f", rest)) {
+            chunk.error = !ParseFace(rest, lineEnd, chunk, face);
+        }
+        else if (Keyword(s, lineEnd, "o", rest) || Keyword(s, lineEnd, "g", rest)) {
+            chunk.events.push_back({ chunk.corners.size(), EVENT_OBJECT, Trimmed(rest, lineEnd) });
+        }
+        else if (Keyword(s, lineEnd, "usemtl", rest)) {
+            chunk.events.push_back({ chunk.corners.size(), EVENT_MATERIAL, Trimmed(rest, lineEnd) });
+        }
+        else if (Keyword(s, lineEnd, "mtllib", rest)) {
+            chunk.libraries.push_back(Trimmed(rest, lineEnd));
+        }
+        p = lineEnd + 1;
+    }
+}
+
+// Wywołuje fn(0..count-1) na najwyżej threads wątkach (bieżący też pracuje)
+template <typename Fn>
+void ParallelFor(int count, int threads, Fn fn)
+{
+    std::atomic<int> next(0);
+    auto work = [&] {
+        for (int i; (i = next++) < count;) fn(i);
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < std::min(threads, count); t++) workers.emplace_back(work);
+    work();
+    for (std::thread& worker : workers) worker.join();
+}
+
+// Sama nazwa pliku (jak Model::materialTexturePath) - ostatnie słowo, bo przed nim mogą być opcje (-bm 1.0)
+std::string TextureFileName(const std::string& value)
+{
+    std::istringstream in(value);
+    std::string word, last;
+    while (in >> word) last = word;
+    std::replace(last.begin(), last.end(), '\\', '/');
+    size_t slash = last.find_last_of('/');
+    return slash == std::string::npos ? last : last.substr(slash + 1);
+}
+
+void ParseMtl(const std::string& path, std::unordered_map<std::string, MaterialMaps>& materials)
+{
+    FileView file = Vfs::Open(path);
+    if (!file.Valid()) {
+        std::cout << "ERROR::OBJ::MTL_NOT_FOUND " << path << std::endl;
+        return;
+    }
+
+    MaterialMaps* current = nullptr;
+    const char* fileEnd = reinterpret_cast<const char*>(file.Data()) + file.Size();
+    for (const char* begin = reinterpret_cast<const char*>(file.Data()), *end; begin < fileEnd; begin = end + 1) {
+        end = static_cast<const char*>(std::memchr(begin, '\n', fileEnd - begin));
+        if (!end) end = fileEnd;
+        const char* s = SkipBlanks(begin, end);
+        const char* keyEnd = s;
+        while (keyEnd < end && !IsBlank(*keyEnd)) keyEnd++;
+        std::string key(s, keyEnd);
+        std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+        if (key == "newmtl") {
+            current = &materials[Trimmed(keyEnd, end)];
+            continue;
+        }
+        if (!current) continue;
+
+        // Te same typy co przy Assimp: diffuse, metalness/reflection, roughness/shininess, normals/height
+        std::string* target = nullptr;
+        if (key == "map_kd") target = &current->primary[TEXTURE_DIFFUSE];
+        else if (key == "map_pm") target = &current->primary[TEXTURE_METALNESS];
+        else if (key == "map_refl" || key == "refl") target = &current->fallback[TEXTURE_METALNESS];
+        else if (key == "map_pr") target = &current->primary[TEXTURE_ROUGHNESS];
+        else if (key == "map_ns") target = &current->fallback[TEXTURE_ROUGHNESS];
+        else if (key == "norm" || key == "map_kn") target = &current->primary[TEXTURE_NORMAL];
+        else if (key == "map_bump" || key == "bump") target = &current->fallback[TEXTURE_NORMAL];
+        if (target && target->empty()) *target = TextureFileName(std::string(keyEnd, end));
+    }
+}
+
+struct Geometry {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texcoords;
+    std::vector<glm::vec3> normals;
+};
+
+// Wierzchołki bez powtórzeń i indeksy jednej siatki; false przy indeksie spoza pliku
+bool BuildPart(const Part& part, const Geometry& g, MeshData& out)
+{
+    int positionCount = (int)g.positions.size();
+    int texcoordCount = (int)g.texcoords.size();
+    int normalCount = (int)g.normals.size();
+
+    bool missingNormals = false;
+    for (const auto& range : part.ranges) {
+        for (const Corner* c = range.first; c != range.second; c++) {
+            if (c->v < 0 || c->v >= positionCount || c->vt < -1 || c->vt >= texcoordCount
+                || c->vn < -1 || c->vn >= normalCount)
+                return false;
+            missingNormals = missingNormals || c->vn < 0;
+        }
+    }
+
+    // Brak normalnych: średnia z normalnych ścian przy każdej pozycji (jak aiProcess_GenSmoothNormals)
+    std::unordered_map<int, glm::vec3> smooth;
+    if (missingNormals) {
+        for (const auto& range : part.ranges) {
+            for (const Corner* c = range.first; c != range.second; c += 3) {
+                glm::vec3 n = glm::cross(g.positions[c[1].v] - g.positions[c[0].v], g.positions[c[2].v] - g.positions[c[0].v]);
+                float length = glm::length(n);
+                if (length <= 0.0f) continue;
+                for (int k = 0; k < 3; k++)
+                    if (c[k].vn < 0) smooth[c[k].v] += n / length;
+            }
+        }
+    }
+
+    std::unordered_map<Corner, unsigned int, CornerHash> unique;
+    unique.reserve(part.cornerCount);
+    out.indices.reserve(part.cornerCount);
+    for (const auto& range : part.ranges) {
+        for (const Corner* c = range.first; c != range.second; c++) {
+            auto inserted = unique.emplace(*c, (unsigned int)out.vertices.size());
+            if (inserted.second) {
+                Vertex vertex;
+                vertex.Position = g.positions[c->v];
+                if (c->vn >= 0) {
+                    vertex.Normal = g.normals[c->vn];
+                }
+                else {
+                    glm::vec3 n = smooth[c->v];
+                    float length = glm::length(n);
+                    vertex.Normal = length > 0.0f ? n / length : glm::vec3(0.0f, 1.0f, 0.0f);
+                }
+                // aiProcess_FlipUVs
+                vertex.TexCoords = c->vt >= 0 ? glm::vec2(g.texcoords[c->vt].x, 1.0f - g.texcoords[c->vt].y)
+                    : glm::vec2(0.0f);
+                out.vertices.push_back(vertex);
+            }
+            out.indices.push_back(inserted.first->second);
+        }
+    }
+    return true;
+}
+
+}
+
+namespace ObjLoader {
+
+bool Load(const std::string& path, std::vector<MeshData>& meshes, int threads)
+{
+    FileView file = Vfs::Open(path);
+    if (!file.Valid()) {
+        std::cout << "ERROR::OBJ::FILE_NOT_FOUND " << path << std::endl;
+        return false;
+    }
+    if (threads <= 0) threads = std::max(1, (int)std::thread::hardware_concurrency());
+
+    // Kawałki po pełnych liniach - każdy parsowany na osobnym wątku
+    const char* data = reinterpret_cast<const char*>(file.Data());
+    const char* dataEnd = data + file.Size();
+    int chunkCount = (int)std::min<size_t>((size_t)threads, std::max<size_t>(1, file.Size() / MIN_CHUNK_BYTES));
+    std::vector<Chunk> chunks(chunkCount);
+    const char* start = data;
+    for (int i = 0; i < chunkCount; i++) {
+        chunks[i].begin = start;
+        if (i + 1 == chunkCount) {
+            chunks[i].end = dataEnd;
+        }
+        else {
+            const char* target = std::max(start, data + file.Size() * (i + 1) / chunkCount);
+            const char* newline = static_cast<const char*>(std::memchr(target, '\n', dataEnd - target));
+            chunks[i].end = newline ? newline + 1 : dataEnd;
+        }
+        start = chunks[i].end;
+    }
+    ParallelFor(chunkCount, threads, [&chunks](int i) { ParseChunk(chunks[i]); });
+
+    // Indeksy względne -> bezwzględne i wspólne tablice pozycji / UV / normalnych
+    Geometry geometry;
+    size_t base[3] = { 0, 0, 0 };
+    for (Chunk& chunk : chunks) {
+        if (chunk.error) {
+            std::cout << "ERROR::OBJ::PARSE " << path << std::endl;
+            return false;
+        }
+        for (size_t r : chunk.relative) {
+            int& index = Component(chunk.corners[r / 3], (int)(r % 3));
+            index += (int)base[r % 3];
+            if (index < 0) {
+                std::cout << "ERROR::OBJ::BAD_INDEX " << path << std::endl;
+                return false;
+            }
+        }
+        geometry.positions.insert(geometry.positions.end(), chunk.positions.begin(), chunk.positions.end());
+        geometry.texcoords.insert(geometry.texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+        geometry.normals.insert(geometry.normals.end(), chunk.normals.begin(), chunk.normals.end());
+        base[0] += chunk.positions.size();
+        base[1] += chunk.texcoords.size();
+        base[2] += chunk.normals.size();
+    }
+
+    // Nowa siatka przy każdym obiekcie i zmianie materiału (pusta siatka tylko zmienia materiał)
+    std::vector<Part> parts(1);
+    std::string material;
+    for (const Chunk& chunk : chunks) {
+        size_t position = 0;
+        auto addRange = [&](size_t end) {
+            if (end == position) return;
+            parts.back().ranges.push_back({ chunk.corners.data() + position, chunk.corners.data() + end });
+            parts.back().cornerCount += end - position;
+            position = end;
+        };
+        for (const Event& event : chunk.events) {
+            addRange(event.corner);
+            if (event.type == EVENT_MATERIAL) {
+                if (event.name == material) continue;
+                material = event.name;
+            }
+            if (parts.back().cornerCount > 0) parts.emplace_back();
+            parts.back().material = material;
+        }
+        addRange(chunk.corners.size());
+    }
+    if (parts.back().cornerCount == 0) parts.pop_back();
+    if (parts.empty()) {
+        std::cout << "ERROR::OBJ::NO_FACES " << path << std::endl;
+        return false;
+    }
+
+    std::unordered_map<std::string, MaterialMaps> materials;
+    size_t slash = path.find_last_of("/\\");
+    std::string directory = slash == std::string::npos ? "" : path.substr(0, slash + 1);
+    for (const Chunk& chunk : chunks)
+        for (const std::string& library : chunk.libraries) ParseMtl(directory + library, materials);
+
+    std::vector<MeshData> result(parts.size());
+    std::vector<char> valid(parts.size(), 0);
+    ParallelFor((int)parts.size(), threads, [&](int i) { valid[i] = BuildPart(parts[i], geometry, result[i]); });
+    for (size_t i = 0; i < parts.size(); i++) {
+        if (!valid[i]) {
+            std::cout << "ERROR::OBJ::BAD_INDEX " << path << std::endl;
+            return false;
+        }
+        auto maps = materials.find(parts[i].material);
+        if (maps == materials.end()) continue;
+        for (int slot = 0; slot < TEXTURE_SLOT_COUNT; slot++)
+            result[i].textures[slot] = !maps->second.primary[slot].empty() ? maps->second.primary[slot]
+                : maps->second.fallback[slot];
+    }
+
+    for (MeshData& mesh : result) meshes.push_back(std::move(mesh));
+    return true;
+}
+
+std::vector<std::string> MaterialLibraries(const unsigned char* data, size_t size)
+{
+    std::vector<std::string> libraries;
+    const char* fileEnd = reinterpret_cast<const char*>(data) + size;
+    for (const char* begin = reinterpret_cast<const char*>(data), *end; begin < fileEnd; begin = end + 1) {
+        end = static_cast<const char*>(std::memchr(begin, '\n', fileEnd - begin));
+        if (!end) end = fileEnd;
+        const char* rest = nullptr;
+        if (Keyword(SkipBlanks(begin, end), end, "mtllib", rest)) libraries.push_back(Trimmed(rest, end));
+    }
+    return libraries;
+}
+
+}
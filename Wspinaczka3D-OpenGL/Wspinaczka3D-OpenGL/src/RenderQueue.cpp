@@ -0,0 +1,314 @@
+#include "RenderQueue.h"
+#include "Mesh.h"
+#include "Model.h"
+#include "Shader.h"
+#include "InstanceBuffer.h"
+#include "TextureManager.h"
+#include <algorithm>
+#include <cmath>
+
+// Największa skala z macierzy - błąd siatki w jednostkach modelu -> jednostki świata
+static float MaxScale(const glm::mat4& m) {
+    return std::max(glm::length(glm::vec3(m[0])), std::max(glm::length(glm::vec3(m[1])), glm::length(glm::vec3(m[2]))));
+}
+
+void RenderQueue::SetLodMetric(float screenHeight, float fovY) {
+    lodPixelsPerUnit = screenHeight / (2.0f * std::tan(fovY * 0.5f));
+}
+
+void RenderQueue::Begin(const glm::vec3& position, const Frustum& camera, const Frustum& light) {
+    viewPos = position;
+    cameraFrustum = camera;
+    lightFrustum = light;
+    items.clear();
+    transforms.clear();
+    frameInstances.clear();
+    transformsUploaded = false;
+}
+
+// Widoczne w którymkolwiek przebiegu
+bool RenderQueue::visible(const AABB& bounds) const {
+    return cameraFrustum.Intersects(bounds) || lightFrustum.Intersects(bounds);
+}
+
+void RenderQueue::push(DrawItem item) {
+    // Statyczne zostają nawet niewidoczne - mogą trafić do zapamiętanych kaskad cieni
+    bool seen = visible(item.bounds);
+    if (!seen && !item.state.staticCaster) return;
+
+    // Siatka bez nadpisanej tekstury rysuje się ze swoim materiałem
+    if (item.mesh && item.texture == 0) {
+        item.material = &item.mesh->material;
+        item.texture = item.material->Diffuse();
+    }
+
+    // Odległość do najbliższego punktu kuli (albo pudełka); bez granic obiekt jest zawsze blisko
+    float distance = 0.0f;
+    if (item.sphere.Valid())
+        distance = std::max(glm::distance(viewPos, item.sphere.center) - item.sphere.radius, 0.0f);
+    else if (item.bounds.Valid())
+        distance = glm::distance(viewPos, glm::clamp(viewPos, item.bounds.min, item.bounds.max));
+
+    // Tekstury strumieniowane - bliższe dostają pełną rozdzielczość pierwsze
+    TextureManager& textures = TextureManager::Instance();
+    if (textures.Streaming() && seen) {
+        if (item.material) {
+            for (unsigned int id : item.material->textures) textures.Touch(id, distance);
+        }
+        else {
+            textures.Touch(item.texture, distance);
+        }
+    }
+
+    // Poziom szczegółów - osobno dla cieni
+    if (item.mesh && !item.instances && !item.positions && lodPixelsPerUnit > 0.0f && item.mesh->lods.size() > 1) {
+        float scale = MaxScale(item.model);
+        item.lod[0] = item.mesh->SelectLod(distance, scale, lodPixelsPerUnit, lodMaxPixels);
+        item.lod[1] = item.mesh->SelectLod(distance, scale, lodPixelsPerUnit, shadowLodMaxPixels);
+    }
+
+    // Macierz normalnych liczona tu, raz na obiekt - shader tylko ją czyta
+    if (!item.instances) {
+        item.transformIndex = (int)(transforms.size() / TRANSFORM_TEXELS);
+        glm::mat3 normalMatrix = NormalMatrix(item.model);
+        for (int c = 0; c < 4; c++) transforms.push_back(item.model[c]);
+        for (int c = 0; c < 3; c++) transforms.push_back(glm::vec4(normalMatrix[c], 0.0f));
+    }
+    items.push_back(std::move(item));
+}
+
+void RenderQueue::Submit(Mesh& mesh, const glm::mat4& model, const DrawState& state, unsigned int texture) {
+    push({ &mesh, nullptr, mesh.VAO, texture, nullptr, model, state, nullptr, 0,
+        glm::distance(viewPos, glm::vec3(model[3])),
+        mesh.bounds.Transformed(model), mesh.sphere.Transformed(model) });
+}
+
+void RenderQueue::Submit(Model& model, const glm::mat4& transform, const DrawState& state) {
+    for (Mesh& mesh : model.meshes) Submit(mesh, transform, state);
+}
+
+void RenderQueue::pushInstanced(Mesh& mesh, const InstanceBuffer& buffer, int first, int count, const DrawState& state,
+    const AABB& bounds, int lod, int shadowLod) {
+    if (count <= 0) return;
+    // Kopie mogą być wszędzie - głębia nic nie mówi, kolejność zgłoszenia zostaje
+    DrawItem item{ &mesh, nullptr, mesh.VAO, 0, nullptr, glm::mat4(1.0f), state, &buffer, count, 0.0f,
+        bounds, BoundingSphere() };
+    item.firstInstance = first;
+    int last = (int)mesh.lods.size() - 1;
+    item.lod[0] = std::min(lod, last);
+    item.lod[1] = std::min(shadowLod, last);
+    push(std::move(item));
+}
+
+void RenderQueue::SubmitInstanced(Mesh& mesh, const InstanceBuffer& buffer, int count, const DrawState& state,
+    const AABB& bounds) {
+    pushInstanced(mesh, buffer, 0, count, state, bounds, 0, 0);
+}
+
+void RenderQueue::SubmitInstanced(Model& model, const InstanceBuffer& buffer, int count, const DrawState& state,
+    const AABB& bounds) {
+    for (Mesh& mesh : model.meshes) SubmitInstanced(mesh, buffer, count, state, bounds);
+}
+
+void RenderQueue::SubmitInstanced(Model& model, const InstanceData* instances, int count, const DrawState& state) {
+    const int levels = (int)model.lodErrors.size();
+    bool useLod = lodPixelsPerUnit > 0.0f && levels > 1;
+
+    instanceOrder.clear();
+    for (int i = 0; i < count; i++) {
+        AABB b = model.bounds.Transformed(instances[i].model);
+        if (!state.staticCaster && !visible(b)) continue;
+
+        int key = 0;
+        if (useLod) {
+            float distance = std::max(glm::distance(viewPos, b.Center()) - glm::length(b.HalfSize()), 0.0f);
+            float scale = MaxScale(instances[i].model);
+            key = model.SelectLod(distance, scale, lodPixelsPerUnit, lodMaxPixels) * levels
+                + model.SelectLod(distance, scale, lodPixelsPerUnit, shadowLodMaxPixels);
+        }
+        instanceOrder.push_back({ key, i, b });
+    }
+    if (instanceOrder.empty()) return;
+
+    // Kopie o tym samym poziomie obok siebie - jedno wysłanie, po jednym rysowaniu na grupę
+    std::stable_sort(instanceOrder.begin(), instanceOrder.end(),
+        [](const VisibleInstance& a, const VisibleInstance& b) { return a.lodKey < b.lodKey; });
+    int base = (int)frameInstances.size();
+    for (const VisibleInstance& v : instanceOrder) frameInstances.push_back(instances[v.index]);
+
+    int visibleCount = (int)instanceOrder.size();
+
+    for (int start = 0; start < visibleCount; ) {
+        int end = start;
+        AABB bounds;
+        while (end < visibleCount && instanceOrder[end].lodKey == instanceOrder[start].lodKey)
+            bounds.Expand(instanceOrder[end++].bounds);
+
+        int key = instanceOrder[start].lodKey;
+        for (Mesh& mesh : model.meshes)
+            pushInstanced(mesh, frameInstanceBuffer, base + start, end - start, state, bounds, key / levels, key % levels);
+        start = end;
+    }
+}
+
+void RenderQueue::SubmitAt(Mesh& mesh, const PositionBuffer& positions, int count, const glm::mat4& model,
+    const DrawState& state, const AABB& bounds) {
+    if (count <= 0) return;
+    DrawItem item{ &mesh, nullptr, mesh.VAO, 0, nullptr, model, state, nullptr, count,
+        glm::distance(viewPos, bounds.Center()), bounds, BoundingSphere() };
+    item.positions = &positions;
+    push(std::move(item));
+}
+
+void RenderQueue::SubmitRaw(unsigned int vao, unsigned int texture, const glm::mat4& model, const DrawState& state,
+    std::function<void()> drawCall, const AABB& bounds) {
+    push({ nullptr, std::move(drawCall), vao, texture, nullptr, model, state, nullptr, 0,
+        glm::distance(viewPos, glm::vec3(model[3])), bounds, BoundingSphere() });
+}
+
+// Klucz (od najstarszego bitu):
+//   zwykły przebieg:  przezroczystość | tekstura | VAO | głębia przód->tył
+//   przezroczyste:    1 | głębia tył->przód | tekstura | VAO
+//   cienie:           VAO | głębia
+uint64_t RenderQueue::sortKey(const DrawItem& item, bool depthOnly) {
+    const uint64_t depthMax = (1u << 24) - 1;
+    uint64_t depth = (uint64_t)std::min(std::max(item.depth, 0.0f) * 16384.0f, (float)depthMax);
+    uint64_t texture = item.texture & 0xFFFF;
+    uint64_t vao = item.vao & 0xFFFF;
+
+    if (depthOnly)
+        return (vao << 24) | depth;
+    if (item.state.pass == PASS_TRANSPARENT)
+        return (1ull << 63) | ((depthMax - depth) << 32) | (texture << 16) | vao;
+    return (texture << 40) | (vao << 24) | depth;
+}
+
+void RenderQueue::uploadTransforms() {
+    if (!transformVBO) {
+        glGenBuffers(1, &transformVBO);
+        glGenTextures(1, &transformTexture);
+        glBindTexture(GL_TEXTURE_BUFFER, transformTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, transformVBO);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+
+    // Nowy magazyn co klatkę - GPU może jeszcze czytać poprzednią
+    glBindBuffer(GL_TEXTURE_BUFFER, transformVBO);
+    glBufferData(GL_TEXTURE_BUFFER, transforms.size() * sizeof(glm::vec4),
+        transforms.empty() ? nullptr : transforms.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    if (!frameInstances.empty()) frameInstanceBuffer.Upload(frameInstances.data(), (int)frameInstances.size());
+    transformsUploaded = true;
+}
+
+void RenderQueue::Flush(Shader& shader, bool depthOnly, CasterFilter casters, const Frustum* cullFrustum) {
+    if (!transformsUploaded) uploadTransforms();
+
+    const Frustum& frustum = cullFrustum ? *cullFrustum : (depthOnly ? lightFrustum : cameraFrustum);
+    culled = 0;
+    triangles = 0;
+
+    order.clear();
+    order.reserve(items.size());
+    for (int i = 0; i < (int)items.size(); i++) {
+        if (casters != CASTERS_ALL && items[i].state.staticCaster != (casters == CASTERS_STATIC)) continue;
+        // najpierw tania kula, potem dokładniejsze pudełko
+        if (!frustum.Intersects(items[i].sphere) || !frustum.Intersects(items[i].bounds)) {
+            culled++;
+            continue;
+        }
+        order.push_back({ sortKey(items[i], depthOnly), i });
+    }
+    std::stable_sort(order.begin(), order.end(),
+        [](const std::pair<uint64_t, int>& a, const std::pair<uint64_t, int>& b) { return a.first < b.first; });
+
+    UniformHandle transformIndexLoc = shader.uniform("transformIndex");
+    shader.set(shader.uniform("transforms"), TRANSFORM_UNIT);
+    glActiveTexture(GL_TEXTURE0 + TRANSFORM_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, transformTexture);
+    UniformHandle instancingLoc = shader.uniform("useInstancing");
+    UniformHandle colorLoc = shader.uniform("objectColor");
+    UniformHandle useTextureLoc = shader.uniform("useTexture");
+    UniformHandle worldUVLoc = shader.uniform("useWorldUV");
+    UniformHandle texWorldSizeLoc = shader.uniform("texWorldSize");
+    UniformHandle twoSidedLoc = shader.uniform("twoSided");
+    UniformHandle upNormalLoc = shader.uniform("forceUpNormal");
+
+    glActiveTexture(GL_TEXTURE0);
+    unsigned int boundVAO = ~0u, boundTexture = ~0u;
+    Material boundMaterial;
+    bool materialBound = false;
+    bool blending = false;
+    textureBinds = vaoBinds = 0;
+
+    for (const auto& entry : order) {
+        const DrawItem& item = items[entry.second];
+
+        if (!depthOnly) {
+            bool blend = item.state.pass == PASS_TRANSPARENT;
+            if (blend != blending) {
+                if (blend) {
+                    glEnable(GL_BLEND);
+                    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                }
+                else {
+                    glDisable(GL_BLEND);
+                }
+                blending = blend;
+            }
+
+            shader.set(colorLoc, item.state.color);
+            shader.set(useTextureLoc, item.state.useTexture ? 1 : 0);
+            shader.set(worldUVLoc, item.state.useWorldUV ? 1 : 0);
+            if (item.state.useWorldUV) shader.set(texWorldSizeLoc, item.state.texWorldSize);
+            shader.set(twoSidedLoc, item.state.twoSided ? 1 : 0);
+            shader.set(upNormalLoc, item.state.forceUpNormal ? 1 : 0);
+
+            if (item.material) {
+                if (!materialBound || !(*item.material == boundMaterial)) {
+                    item.material->Bind(shader.materialSlots);
+                    boundMaterial = *item.material;
+                    materialBound = true;
+                    boundTexture = item.material->Diffuse();
+                    textureBinds++;
+                }
+            }
+            else if (item.texture != 0 && item.texture != boundTexture) {
+                glBindTexture(GL_TEXTURE_2D, item.texture);
+                boundTexture = item.texture;
+                materialBound = false; // jednostka 0 nie zgadza się już z materiałem
+                textureBinds++;
+            }
+        }
+
+        if (item.vao != boundVAO) {
+            glBindVertexArray(item.vao);
+            boundVAO = item.vao;
+            vaoBinds++;
+        }
+
+        int lod = item.lod[depthOnly ? 1 : 0];
+        if (item.instances) {
+            shader.set(instancingLoc, 1);
+            item.mesh->DrawBoundInstanced(item.instances->VBO, item.instanceCount, item.firstInstance, lod);
+            triangles += item.mesh->lods[lod].count / 3 * item.instanceCount;
+        }
+        else {
+            shader.set(instancingLoc, 0);
+            shader.set(transformIndexLoc, item.transformIndex);
+            if (item.positions) {
+                item.mesh->DrawBoundAt(item.positions->VBO, item.instanceCount, lod);
+                triangles += item.mesh->lods[lod].count / 3 * item.instanceCount;
+            }
+            else if (item.mesh) {
+                item.mesh->DrawBound(lod);
+                triangles += item.mesh->lods[lod].count / 3;
+            }
+            else item.drawCall();
+        }
+    }
+
+    glBindVertexArray(0);
+    if (blending) glDisable(GL_BLEND);
+}
@@ -1,29 +1,31 @@
 #include "Shader.h"
+#include "FrameUniforms.h"
+#include "Material.h"
+#include "Vfs.h"
+#include "AssetPath.h"
 
-#include <fstream>
-#include <sstream>
 #include <iostream>
+#include <cstring>
+
+namespace {
+    // Hash nazwy - szybkie odrzucanie nazw zanim porównamy stringi
+    uint64_t HashName(const char* s) {
+        return Fnv1a(s, std::strlen(s));
+    }
+}
 
 Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     std::string vertexCode;
     std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
-    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try {
-        vShaderFile.open(vertexPath);
-        fShaderFile.open(fragmentPath);
-        std::stringstream vShaderStream, fShaderStream;
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();
-        vShaderFile.close();
-        fShaderFile.close();
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
+    FileView vShaderFile = Vfs::Open(vertexPath);
+    FileView fShaderFile = Vfs::Open(fragmentPath);
+    if (vShaderFile.Valid() && fShaderFile.Valid()) {
+        vertexCode.assign(reinterpret_cast<const char*>(vShaderFile.Data()), vShaderFile.Size());
+        fragmentCode.assign(reinterpret_cast<const char*>(fShaderFile.Data()), fShaderFile.Size());
     }
-    catch (std::ifstream::failure& e) {
-        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: " << e.what() << std::endl;
+    else {
+        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: "
+            << (vShaderFile.Valid() ? fragmentPath : vertexPath) << std::endl;
     }
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
@@ -43,29 +45,112 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     checkCompileErrors(ID, "PROGRAM");
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+
+    reflectUniforms();
+
+    // Blok danych klatki (jeśli shader go używa) zawsze pod tym samym punktem wiązania
+    GLuint frameBlock = glGetUniformBlockIndex(ID, "FrameData");
+    if (frameBlock != GL_INVALID_INDEX)
+        glUniformBlockBinding(ID, frameBlock, FrameUniforms::BINDING);
+
+    // Samplery materiału mają stałe jednostki - ustawiane raz, nie przy każdym rysowaniu
+    materialSlots = Material::ResolveSamplers(*this);
+}
+
+// Spis aktywnych uniformów po linkowaniu - potem żadnego glGetUniformLocation w trakcie klatki
+void Shader::reflectUniforms() {
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<char> buffer(maxLength > 0 ? maxLength : 1);
+    for (GLint i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, (GLuint)i, (GLsizei)buffer.size(), &length, &size, &type, buffer.data());
+
+        std::string name(buffer.data(), length);
+        // tablice przychodzą jako "nazwa[0]" - każdy element dostaje własny wpis
+        std::string base = name;
+        size_t bracket = base.find('[');
+        if (bracket != std::string::npos)
+            base.erase(bracket);
+
+        for (GLint element = 0; element < size; element++) {
+            std::string elementName = (size > 1 || bracket != std::string::npos)
+                ? base + "[" + std::to_string(element) + "]"
+                : base;
+            GLint location = glGetUniformLocation(ID, elementName.c_str());
+            if (location < 0)
+                continue; // uniform z bloku (UBO) - nie ustawia się go przez glUniform
+
+            Uniform u;
+            u.location = location;
+            u.type = type;
+            u.known = false;
+            std::memset(u.value, 0, sizeof(u.value));
+            UniformHandle handle = (UniformHandle)uniforms.size();
+            uniforms.push_back(u);
+
+            names.push_back({ elementName, HashName(elementName.c_str()), handle });
+            // "nazwa[0]" jest też dostępna jako samo "nazwa"
+            if (element == 0 && elementName != base)
+                names.push_back({ base, HashName(base.c_str()), handle });
+        }
+    }
+}
+
+UniformHandle Shader::uniform(const char* name) const {
+    uint64_t hash = HashName(name);
+    for (const UniformName& n : names) {
+        if (n.hash == hash && n.name == name)
+            return n.handle;
+    }
+    return -1;
+}
+
+// true = trzeba wysłać do GL (i kopia jest już zaktualizowana)
+bool Shader::changed(UniformHandle handle, const void* data, size_t size) const {
+    if (handle < 0)
+        return false;
+
+    Uniform& u = uniforms[handle];
+    if (u.known && std::memcmp(u.value, data, size) == 0) {
+        stats.skipped++;
+        return false;
+    }
+    std::memcpy(u.value, data, size);
+    u.known = true;
+    stats.issued++;
+    return true;
 }
 
 void Shader::use() { glUseProgram(ID); }
 
-void Shader::setMat4(const std::string& name, const glm::mat4& mat) const {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::set(UniformHandle handle, const glm::mat4& mat) const {
+    if (changed(handle, &mat[0][0], sizeof(glm::mat4)))
+        glUniformMatrix4fv(uniforms[handle].location, 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::setVec3(const std::string& name, const glm::vec3& value) const {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+void Shader::set(UniformHandle handle, const glm::vec3& value) const {
+    if (changed(handle, &value[0], sizeof(glm::vec3)))
+        glUniform3fv(uniforms[handle].location, 1, &value[0]);
 }
 
-void Shader::setVec4(const std::string& name, const glm::vec4& value) const
-{
-    glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+void Shader::set(UniformHandle handle, const glm::vec4& value) const {
+    if (changed(handle, &value[0], sizeof(glm::vec4)))
+        glUniform4fv(uniforms[handle].location, 1, &value[0]);
 }
 
-void Shader::setInt(const std::string& name, int value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+void Shader::set(UniformHandle handle, int value) const {
+    if (changed(handle, &value, sizeof(int)))
+        glUniform1i(uniforms[handle].location, value);
 }
 
-void Shader::setFloat(const std::string& name, float value) const {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+void Shader::set(UniformHandle handle, float value) const {
+    if (changed(handle, &value, sizeof(float)))
+        glUniform1f(uniforms[handle].location, value);
 }
 
 void Shader::checkCompileErrors(unsigned int shader, std::string type) {
@@ -0,0 +1,199 @@
+#include "ShadowMap.h"
+#include "RenderQueue.h"
+#include "Shader.h"
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+ShadowMap::ShadowMap(const ShadowSettings& s) : settings(s) {
+    cascadeCount = std::min(std::max(settings.cascadeCount, 1), MAX_SHADOW_CASCADES);
+
+    // Kaskady obok siebie w jednym rzędzie atlasu
+    for (int i = 0; i < cascadeCount; i++) {
+        cascades[i].x = atlasWidth;
+        cascades[i].size = settings.resolution[i];
+        atlasWidth += cascades[i].size;
+        atlasHeight = std::max(atlasHeight, cascades[i].size);
+    }
+
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+    if ((GLint)atlasWidth > maxSize)
+        std::cout << "ERROR::SHADOWMAP::ATLAS_TOO_LARGE " << atlasWidth << " > " << maxSize << std::endl;
+
+    staticDepth = createDepthTexture(atlasWidth, atlasHeight);
+    staticFBO = createFramebuffer(staticDepth);
+    depthMap = createDepthTexture(atlasWidth, atlasHeight);
+    depthFBO = createFramebuffer(depthMap);
+}
+
+ShadowMap::~ShadowMap() {
+    glDeleteFramebuffers(1, &staticFBO);
+    glDeleteFramebuffers(1, &depthFBO);
+    glDeleteTextures(1, &staticDepth);
+    glDeleteTextures(1, &depthMap);
+}
+
+// Obie tekstury muszą mieć ten sam format, inaczej blit głębi się nie uda.
+// Tryb porównania + GL_LINEAR: sampler2DShadow zwraca od razu przefiltrowane 2x2 oświetlenie.
+unsigned int ShadowMap::createDepthTexture(unsigned int w, unsigned int h) {
+    unsigned int tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, w, h, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return tex;
+}
+
+unsigned int ShadowMap::createFramebuffer(unsigned int depthTexture) {
+    unsigned int fbo;
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "ERROR::SHADOWMAP::FRAMEBUFFER_NOT_COMPLETE" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return fbo;
+}
+
+// Macierz światła obejmująca kulę wokół podanych narożników.
+// snap: rozmiar zaokrąglony, środek przesuwany skokami co cacheSnapTexels tekseli
+// (z marginesem pół skoku, żeby przesunięty kwadrat nadal obejmował całą kulę)
+glm::mat4 ShadowMap::fitLightSpace(const glm::vec3 corners[8], const glm::vec3& lightDir, unsigned int size, bool snap) const {
+    glm::vec3 center(0.0f);
+    for (int i = 0; i < 8; i++) center += corners[i];
+    center /= 8.0f;
+
+    float radius = 0.0f;
+    for (int i = 0; i < 8; i++) radius = std::max(radius, glm::length(corners[i] - center));
+
+    glm::vec3 up = std::abs(lightDir.y) > 0.99f ? glm::vec3(0, 0, 1) : glm::vec3(0, 1, 0);
+    float halfSize = radius;
+
+    if (snap) {
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+        int snapTexels = std::min(std::max(settings.cacheSnapTexels, 1), (int)size / 4);
+        halfSize = radius / (1.0f - (float)snapTexels / size);
+        float step = 2.0f * halfSize / size * snapTexels;
+
+        glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), lightDir, up);
+        glm::vec3 c = glm::vec3(lightRotation * glm::vec4(center, 1.0f));
+        c = glm::round(c / step) * step;
+        center = glm::vec3(glm::inverse(lightRotation) * glm::vec4(c, 1.0f));
+    }
+
+    float back = halfSize + settings.casterMargin;
+    glm::mat4 lightView = glm::lookAt(center - lightDir * back, center, up);
+    glm::mat4 lightProjection = glm::ortho(-halfSize, halfSize, -halfSize, halfSize, 0.0f, back + halfSize);
+    return lightProjection * lightView;
+}
+
+void ShadowMap::Update(const glm::mat4& view, float fovY, float aspect, float nearPlane, const glm::vec3& lightDir) {
+    float farPlane = settings.distance;
+
+    // Narożniki odcinka bryły widzenia kamery [n, f] w świecie
+    auto sliceCorners = [&](float n, float f, glm::vec3 out[8]) {
+        glm::mat4 inv = glm::inverse(glm::perspective(fovY, aspect, n, f) * view);
+        int k = 0;
+        for (int x = -1; x <= 1; x += 2)
+            for (int y = -1; y <= 1; y += 2)
+                for (int z = -1; z <= 1; z += 2) {
+                    glm::vec4 p = inv * glm::vec4((float)x, (float)y, (float)z, 1.0f);
+                    out[k++] = glm::vec3(p) / p.w;
+                }
+    };
+
+    // Podział mieszany: liniowy daleko, logarytmiczny blisko kamery
+    float splitNear = nearPlane;
+    for (int i = 0; i < cascadeCount; i++) {
+        float t = (float)(i + 1) / cascadeCount;
+        float logSplit = nearPlane * std::pow(farPlane / nearPlane, t);
+        float linSplit = nearPlane + (farPlane - nearPlane) * t;
+        float splitFar = glm::mix(linSplit, logSplit, settings.splitLambda);
+
+        glm::vec3 corners[8];
+        sliceCorners(splitNear, splitFar, corners);
+
+        Cascade& c = cascades[i];
+        c.splitFar = splitFar;
+        c.lightSpace = fitLightSpace(corners, lightDir, c.size, true);
+        c.frustum = Frustum::FromMatrix(c.lightSpace);
+        splitNear = splitFar;
+    }
+
+    glm::vec3 corners[8];
+    sliceCorners(nearPlane, farPlane, corners);
+    coverFrustum = Frustum::FromMatrix(fitLightSpace(corners, lightDir, 0, false));
+}
+
+void ShadowMap::Fill(FrameData& frame) const {
+    for (int i = 0; i < cascadeCount; i++) {
+        const Cascade& c = cascades[i];
+        frame.cascadeMatrices[i] = c.lightSpace;
+        frame.cascadeRects[i] = glm::vec4((float)c.x / atlasWidth, 0.0f,
+            (float)c.size / atlasWidth, (float)c.size / atlasHeight);
+        frame.cascadeSplits[i] = c.splitFar;
+    }
+    frame.cascadeCount = cascadeCount;
+}
+
+void ShadowMap::Render(RenderQueue& queue, Shader& depthShader) {
+    depthShader.use();
+    UniformHandle cascadeLoc = depthShader.uniform("cascade");
+
+    // Kaskada przeskoczyła o krok - jej stara część statyczna jest do wyrzucenia
+    bool anyStale = false;
+    for (int i = 0; i < cascadeCount; i++) {
+        Cascade& c = cascades[i];
+        if (c.lightSpace != c.cachedLightSpace) {
+            c.cachedLightSpace = c.lightSpace;
+            c.staticValid = false;
+        }
+        anyStale |= !c.staticValid;
+    }
+
+    if (anyStale) {
+        glBindFramebuffer(GL_FRAMEBUFFER, staticFBO);
+        glEnable(GL_SCISSOR_TEST); // glClear czyści tylko prostokąt tej kaskady
+        for (int i = 0; i < cascadeCount; i++) {
+            Cascade& c = cascades[i];
+            if (c.staticValid) continue;
+            glViewport(c.x, 0, c.size, c.size);
+            glScissor(c.x, 0, c.size, c.size);
+            glClear(GL_DEPTH_BUFFER_BIT);
+            depthShader.set(cascadeLoc, i);
+            queue.Flush(depthShader, true, CASTERS_STATIC, &c.frustum);
+            c.staticValid = true;
+            staticRebuilds++;
+        }
+        glDisable(GL_SCISSOR_TEST);
+    }
+
+    // Kopia zapamiętanej głębi zamiast czyszczenia i rysowania całej sceny
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, staticFBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, depthFBO);
+    glBlitFramebuffer(0, 0, atlasWidth, atlasHeight, 0, 0, atlasWidth, atlasHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, depthFBO);
+    for (int i = 0; i < cascadeCount; i++) {
+        const Cascade& c = cascades[i];
+        glViewport(c.x, 0, c.size, c.size);
+        depthShader.set(cascadeLoc, i);
+        queue.Flush(depthShader, true, CASTERS_DYNAMIC, &c.frustum);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
@@ -1,8 +1,6 @@
 #include "Skybox.h"
 #include <iostream>
 
-#include "stb_image.h"
-
 Skybox::Skybox(const std::vector<std::string>& faces)
     : skyboxShader("assets/shaders/skybox.vs.glsl", "assets/shaders/skybox.fs.glsl")
 {
@@ -13,6 +11,16 @@ Skybox::Skybox(const std::vector<std::string>& faces)
     skyboxShader.setInt("skybox", 0);
 }
 
+Skybox::Skybox(const std::vector<DecodedImage>& faces)
+    : skyboxShader("assets/shaders/skybox.vs.glsl", "assets/shaders/skybox.fs.glsl")
+{
+    setupMesh();
+    cubemapTexture = createCubemap(faces);
+
+    skyboxShader.use();
+    skyboxShader.setInt("skybox", 0);
+}
+
 void Skybox::setupMesh()
 {
     float skyboxVertices[] = {
@@ -74,34 +82,27 @@ void Skybox::setupMesh()
 }
 
 unsigned int Skybox::loadCubemap(const std::vector<std::string>& faces)
+{
+    std::vector<DecodedImage> images;
+    for (const std::string& face : faces)
+    {
+        images.push_back(DecodedImage::Decode(face, false));
+        if (!images.back().Valid())
+            std::cout << "Cubemap texture failed to load at path: " << face << "\n";
+    }
+    return createCubemap(images);
+}
+
+unsigned int Skybox::createCubemap(const std::vector<DecodedImage>& faces)
 {
     unsigned int textureID;
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 
-    stbi_set_flip_vertically_on_load(false); 
-
-    int width, height, nrChannels;
     for (unsigned int i = 0; i < faces.size(); i++)
     {
-        unsigned char* data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
-        if (data)
-        {
-            GLenum format = GL_RGB;
-            if (nrChannels == 1) format = GL_RED;
-            else if (nrChannels == 3) format = GL_RGB;
-            else if (nrChannels == 4) format = GL_RGBA;
-
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
-                0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-
-            stbi_image_free(data);
-        }
-        else
-        {
-            std::cout << "Cubemap texture failed to load at path: " << faces[i] << "\n";
-            stbi_image_free(data);
-        }
+        if (faces[i].Valid())
+            TextureManager::Instance().UploadImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, faces[i]);
     }
 
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -113,17 +114,13 @@ unsigned int Skybox::loadCubemap(const std::vector<std::string>& faces)
     return textureID;
 }
 
-void Skybox::Draw(const glm::mat4& view, const glm::mat4& projection)
+void Skybox::Draw()
 {
     glDepthFunc(GL_LEQUAL); // skybox ma przej "za" wszystko
 
     skyboxShader.use();
 
-    // view bez translacji 
-    glm::mat4 viewNoTranslate = glm::mat4(glm::mat3(view));
-    skyboxShader.setMat4("view", viewNoTranslate);
-    skyboxShader.setMat4("projection", projection);
-
+    // view i projection z bloku FrameData (translacj usuwa shader)
     glBindVertexArray(skyboxVAO);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTexture);
@@ -0,0 +1,40 @@
+#include "StaticBatch.h"
+#include "Model.h"
+#include "RenderQueue.h"
+
+StaticBatch::~StaticBatch() {
+    for (Mesh* m : meshes) delete m;
+}
+
+void StaticBatch::Add(const Model& model, const glm::mat4& transform) {
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+
+    for (const Mesh& mesh : model.meshes) {
+        Bucket& b = buckets[mesh.material];
+
+        unsigned int base = (unsigned int)b.vertices.size();
+        for (const Vertex& v : mesh.vertices) {
+            Vertex w = v;
+            w.Position = glm::vec3(transform * glm::vec4(v.Position, 1.0f));
+            w.Normal = glm::normalize(normalMatrix * v.Normal);
+            b.vertices.push_back(w);
+        }
+        for (unsigned int i : mesh.indices) b.indices.push_back(base + i);
+    }
+}
+
+void StaticBatch::Build() {
+    for (auto& entry : buckets) {
+        Bucket& b = entry.second;
+        if (b.vertices.empty() || b.indices.empty()) continue;
+        meshes.push_back(new Mesh(b.vertices, b.indices, entry.first));
+    }
+    // Dane są już na GPU (kopie w Mesh zostają tak jak w zwykłych modelach)
+    buckets.clear();
+}
+
+void StaticBatch::Submit(RenderQueue& queue) {
+    DrawState state;
+    state.staticCaster = true;
+    for (Mesh* m : meshes) queue.Submit(*m, glm::mat4(1.0f), state);
+}
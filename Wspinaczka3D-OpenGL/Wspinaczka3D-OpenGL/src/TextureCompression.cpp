@@ -0,0 +1,537 @@
+#include "TextureCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+// =====================
+// Kodowanie bloków
+// =====================
+
+// Kolor 5:6:5 i z powrotem do 8 bitów (tak jak rozwija go sprzęt)
+uint16_t Pack565(const float c[3])
+{
+    int r = std::min(31, std::max(0, (int)std::lround(c[0] * 31.0f / 255.0f)));
+    int g = std::min(63, std::max(0, (int)std::lround(c[1] * 63.0f / 255.0f)));
+    int b = std::min(31, std::max(0, (int)std::lround(c[2] * 31.0f / 255.0f)));
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+void Unpack565(uint16_t v, float out[3])
+{
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    out[0] = (float)((r << 3) | (r >> 2));
+    out[1] = (float)((g << 2) | (g >> 4));
+    out[2] = (float)((b << 3) | (b >> 2));
+}
+
+float Distance2(const float a[3], const float b[3])
+{
+    float dr = a[0] - b[0], dg = a[1] - b[1], db = a[2] - b[2];
+    return dr * dr + dg * dg + db * db;
+}
+
+// Indeksy 4-kolorowej palety dla końców c0 > c1; zwraca błąd kwadratowy
+float BC1Indices(const float pixels[16][3], uint16_t c0, uint16_t c1, uint32_t& indices)
+{
+    float palette[4][3];
+    Unpack565(c0, palette[0]);
+    Unpack565(c1, palette[1]);
+    for (int k = 0; k < 3; k++) {
+        palette[2][k] = (2.0f * palette[0][k] + palette[1][k]) / 3.0f;
+        palette[3][k] = (palette[0][k] + 2.0f * palette[1][k]) / 3.0f;
+    }
+
+    float error = 0.0f;
+    indices = 0;
+    for (int i = 0; i < 16; i++) {
+        int best = 0;
+        float bestDistance = Distance2(pixels[i], palette[0]);
+        for (int p = 1; p < 4; p++) {
+            float d = Distance2(pixels[i], palette[p]);
+            if (d < bestDistance) {
+                bestDistance = d;
+                best = p;
+            }
+        }
+        indices |= (uint32_t)best << (2 * i);
+        error += bestDistance;
+    }
+    return error;
+}
+
+// Końce w kolejności c0 > c1 (tryb 4 kolorów); równe końce = jeden kolor, indeksy 0
+void WriteBC1(unsigned char* out, uint16_t c0, uint16_t c1, uint32_t indices)
+{
+    out[0] = (unsigned char)(c0 & 0xFF);
+    out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xFF);
+    out[3] = (unsigned char)(c1 >> 8);
+    for (int i = 0; i < 4; i++) out[4 + i] = (unsigned char)(indices >> (8 * i));
+}
+
+float EncodeEndpoints(const float pixels[16][3], const float hi[3], const float lo[3],
+    uint16_t& c0, uint16_t& c1, uint32_t& indices)
+{
+    c0 = Pack565(hi);
+    c1 = Pack565(lo);
+    if (c0 < c1) std::swap(c0, c1);
+    if (c0 == c1) {
+        indices = 0;
+        float color[3], error = 0.0f;
+        Unpack565(c0, color);
+        for (int i = 0; i < 16; i++) error += Distance2(pixels[i], color);
+        return error;
+    }
+    return BC1Indices(pixels, c0, c1, indices);
+}
+
+// Kolor: końce na głównej osi rozrzutu kolorów bloku, potem jedna poprawka najmniejszych kwadratów
+void EncodeBC1Block(const float pixels[16][3], unsigned char* out)
+{
+    float mean[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; i++)
+        for (int k = 0; k < 3; k++) mean[k] += pixels[i][k] / 16.0f;
+
+    float cov[6] = { 0, 0, 0, 0, 0, 0 }; // rr rg rb gg gb bb
+    for (int i = 0; i < 16; i++) {
+        float d[3] = { pixels[i][0] - mean[0], pixels[i][1] - mean[1], pixels[i][2] - mean[2] };
+        cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+    }
+
+    // Metoda potęgowa - kilka iteracji wystarcza dla 3x3
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iter = 0; iter < 8; iter++) {
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float len = std::sqrt(x * x + y * y + z * z);
+        if (len < 1e-6f) break;
+        axis[0] = x / len; axis[1] = y / len; axis[2] = z / len;
+    }
+
+    float tMin = 1e30f, tMax = -1e30f;
+    for (int i = 0; i < 16; i++) {
+        float t = (pixels[i][0] - mean[0]) * axis[0] + (pixels[i][1] - mean[1]) * axis[1] + (pixels[i][2] - mean[2]) * axis[2];
+        tMin = std::min(tMin, t);
+        tMax = std::max(tMax, t);
+    }
+    // Lekko do środka - skrajne piksele i tak trafią w najbliższy kolor palety
+    float inset = (tMax - tMin) / 16.0f;
+    tMin += inset;
+    tMax -= inset;
+
+    float hi[3], lo[3];
+    for (int k = 0; k < 3; k++) {
+        hi[k] = mean[k] + axis[k] * tMax;
+        lo[k] = mean[k] + axis[k] * tMin;
+    }
+
+    uint16_t c0, c1;
+    uint32_t indices;
+    float error = EncodeEndpoints(pixels, hi, lo, c0, c1, indices);
+
+    // Końce dopasowane do wybranych indeksów (wagi palety: 1, 0, 2/3, 1/3 koloru c0)
+    if (c0 != c1) {
+        static const float weight[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+        float aa = 0, ab = 0, bb = 0, ax[3] = { 0, 0, 0 }, bx[3] = { 0, 0, 0 };
+        for (int i = 0; i < 16; i++) {
+            float a = weight[(indices >> (2 * i)) & 3], b = 1.0f - a;
+            aa += a * a; ab += a * b; bb += b * b;
+            for (int k = 0; k < 3; k++) {
+                ax[k] += a * pixels[i][k];
+                bx[k] += b * pixels[i][k];
+            }
+        }
+        float det = aa * bb - ab * ab;
+        if (std::fabs(det) > 1e-6f) {
+            float refinedHi[3], refinedLo[3];
+            for (int k = 0; k < 3; k++) {
+                refinedHi[k] = (ax[k] * bb - bx[k] * ab) / det;
+                refinedLo[k] = (bx[k] * aa - ax[k] * ab) / det;
+            }
+            uint16_t r0, r1;
+            uint32_t refinedIndices;
+            float refinedError = EncodeEndpoints(pixels, refinedHi, refinedLo, r0, r1, refinedIndices);
+            if (refinedError < error) {
+                c0 = r0;
+                c1 = r1;
+                indices = refinedIndices;
+            }
+        }
+    }
+
+    WriteBC1(out, c0, c1, indices);
+}
+
+// Jeden kanał (BC4, alfa w BC3): końce = min i max, 8 wartości pomiędzy, indeksy po 3 bity
+void EncodeBC4Block(const unsigned char values[16], unsigned char* out)
+{
+    unsigned char mn = 255, mx = 0;
+    for (int i = 0; i < 16; i++) {
+        mn = std::min(mn, values[i]);
+        mx = std::max(mx, values[i]);
+    }
+
+    out[0] = mx;
+    out[1] = mn;
+    uint64_t indices = 0;
+    if (mx != mn) {
+        float palette[8];
+        palette[0] = mx;
+        palette[1] = mn;
+        for (int i = 2; i < 8; i++) palette[i] = ((8 - i) * (float)mx + (i - 1) * (float)mn) / 7.0f;
+
+        for (int i = 0; i < 16; i++) {
+            int best = 0;
+            float bestDistance = std::fabs(values[i] - palette[0]);
+            for (int p = 1; p < 8; p++) {
+                float d = std::fabs(values[i] - palette[p]);
+                if (d < bestDistance) {
+                    bestDistance = d;
+                    best = p;
+                }
+            }
+            indices |= (uint64_t)best << (3 * i);
+        }
+    }
+    for (int i = 0; i < 6; i++) out[2 + i] = (unsigned char)(indices >> (8 * i));
+}
+
+// Mipmapa o połowę mniejsza (średnia 2x2, przy nieparzystych wymiarach ostatni wiersz/kolumna powtórzone)
+std::vector<unsigned char> Downsample(const std::vector<unsigned char>& src, int width, int height)
+{
+    int w = std::max(1, width / 2), h = std::max(1, height / 2);
+    std::vector<unsigned char> dst((size_t)w * h * 4);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+            int y0 = std::min(2 * y, height - 1), y1 = std::min(2 * y + 1, height - 1);
+            for (int k = 0; k < 4; k++) {
+                int sum = src[((size_t)y0 * width + x0) * 4 + k] + src[((size_t)y0 * width + x1) * 4 + k]
+                    + src[((size_t)y1 * width + x0) * 4 + k] + src[((size_t)y1 * width + x1) * 4 + k];
+                dst[((size_t)y * w + x) * 4 + k] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+    return dst;
+}
+
+std::vector<unsigned char> CompressLevel(const unsigned char* rgba, int width, int height, BlockFormat format)
+{
+    int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    int blockBytes = TextureCompression::BlockBytes(format);
+    std::vector<unsigned char> out((size_t)blocksX * blocksY * blockBytes);
+
+    for (int by = 0; by < blocksY; by++) {
+        for (int bx = 0; bx < blocksX; bx++) {
+            // Blok 4x4, na krawędziach powtórzone ostatnie piksele
+            unsigned char texel[16][4];
+            for (int i = 0; i < 16; i++) {
+                int x = std::min(bx * 4 + (i & 3), width - 1);
+                int y = std::min(by * 4 + (i >> 2), height - 1);
+                std::memcpy(texel[i], rgba + ((size_t)y * width + x) * 4, 4);
+            }
+
+            unsigned char* block = &out[((size_t)by * blocksX + bx) * blockBytes];
+            unsigned char channel[16];
+            float color[16][3];
+            switch (format) {
+            case BLOCK_BC1:
+            case BLOCK_BC3:
+                for (int i = 0; i < 16; i++)
+                    for (int k = 0; k < 3; k++) color[i][k] = texel[i][k];
+                if (format == BLOCK_BC3) {
+                    for (int i = 0; i < 16; i++) channel[i] = texel[i][3];
+                    EncodeBC4Block(channel, block);
+                    block += 8;
+                }
+                EncodeBC1Block(color, block);
+                break;
+            case BLOCK_BC4:
+            case BLOCK_BC5:
+                for (int i = 0; i < 16; i++) channel[i] = texel[i][0];
+                EncodeBC4Block(channel, block);
+                if (format == BLOCK_BC5) {
+                    for (int i = 0; i < 16; i++) channel[i] = texel[i][1];
+                    EncodeBC4Block(channel, block + 8);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+// =====================
+// KTX 2.0
+// =====================
+
+const unsigned char KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+struct Ktx2Header {
+    unsigned char identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth, pixelHeight, pixelDepth;
+    uint32_t layerCount, faceCount, levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset, dfdByteLength;
+    uint32_t kvdByteOffset, kvdByteLength;
+    uint64_t sgdByteOffset, sgdByteLength;
+};
+
+struct Ktx2Level {
+    uint64_t byteOffset, byteLength, uncompressedByteLength;
+};
+
+// VkFormat (*_UNORM_BLOCK) i model koloru z Khronos Data Format dla każdego BlockFormat
+const uint32_t VK_FORMATS[BLOCK_FORMAT_COUNT] = { 131, 137, 139, 141 };
+const uint32_t DF_MODELS[BLOCK_FORMAT_COUNT] = { 128, 130, 131, 132 };
+
+size_t Align(size_t n, size_t alignment) { return (n + alignment - 1) / alignment * alignment; }
+
+void Put32(std::vector<unsigned char>& out, uint32_t v)
+{
+    for (int i = 0; i < 4; i++) out.push_back((unsigned char)(v >> (8 * i)));
+}
+
+// Opis formatu (Data Format Descriptor) - jeden blok podstawowy, próbka na każdą część bloku
+std::vector<unsigned char> BuildDfd(BlockFormat format)
+{
+    struct Sample { uint32_t bitOffset; uint32_t channel; };
+    std::vector<Sample> samples;
+    switch (format) {
+    case BLOCK_BC1: samples = { { 0, 0 } }; break;            // kolor
+    case BLOCK_BC3: samples = { { 0, 15 }, { 64, 0 } }; break; // alfa, kolor
+    case BLOCK_BC4: samples = { { 0, 0 } }; break;            // R
+    default:        samples = { { 0, 0 }, { 64, 1 } }; break; // R, G
+    }
+
+    std::vector<unsigned char> block;
+    uint32_t blockSize = 24 + 16 * (uint32_t)samples.size();
+    Put32(block, 4 + blockSize);             // całkowity rozmiar DFD
+    Put32(block, 0);                         // vendor Khronos, typ podstawowy
+    Put32(block, 2 | (blockSize << 16));     // wersja 1.3, rozmiar bloku
+    Put32(block, DF_MODELS[format] | (1 << 8) | (1 << 16)); // model, BT.709, liniowa
+    Put32(block, 3 | (3 << 8));              // blok 4x4
+    Put32(block, (uint32_t)TextureCompression::BlockBytes(format)); // bajty na płaszczyznę 0
+    Put32(block, 0);
+    for (const Sample& s : samples) {
+        Put32(block, s.bitOffset | (63u << 16) | (s.channel << 24)); // 64 bity
+        Put32(block, 0);                     // pozycja próbki
+        Put32(block, 0);                     // dolna wartość
+        Put32(block, 0xFFFFFFFFu);           // górna wartość
+    }
+    return block;
+}
+
+void PutKeyValue(std::vector<unsigned char>& out, const std::string& key, const std::string& value)
+{
+    Put32(out, (uint32_t)(key.size() + value.size() + 2));
+    out.insert(out.end(), key.begin(), key.end());
+    out.push_back(0);
+    out.insert(out.end(), value.begin(), value.end());
+    out.push_back(0);
+    while (out.size() % 4) out.push_back(0);
+}
+
+// Wartość klucza z bloku key/value ("" gdy brak)
+std::string FindKeyValue(const unsigned char* data, size_t size, const std::string& key)
+{
+    size_t offset = 0;
+    while (offset + 4 <= size) {
+        uint32_t length;
+        std::memcpy(&length, data + offset, 4);
+        offset += 4;
+        if (length > size - offset) break;
+        const char* entry = reinterpret_cast<const char*>(data + offset);
+        size_t keyLength = strnlen(entry, length);
+        if (keyLength < length && key.compare(0, std::string::npos, entry, keyLength) == 0) {
+            size_t valueLength = strnlen(entry + keyLength + 1, length - keyLength - 1);
+            return std::string(entry + keyLength + 1, valueLength);
+        }
+        offset = Align(offset + length, 4);
+    }
+    return "";
+}
+
+}
+
+size_t CompressedTexture::Bytes() const
+{
+    size_t total = 0;
+    for (const auto& level : levels) total += level.size();
+    return total;
+}
+
+namespace TextureCompression {
+
+int BlockBytes(BlockFormat format)
+{
+    return (format == BLOCK_BC1 || format == BLOCK_BC4) ? 8 : 16;
+}
+
+const char* FormatName(BlockFormat format)
+{
+    static const char* names[BLOCK_FORMAT_COUNT] = { "BC1", "BC3", "BC4", "BC5" };
+    return format < BLOCK_FORMAT_COUNT ? names[format] : "?";
+}
+
+size_t LevelBytes(BlockFormat format, int width, int height)
+{
+    return (size_t)((width + 3) / 4) * ((height + 3) / 4) * BlockBytes(format);
+}
+
+BlockFormat ChooseFormat(const unsigned char* rgba, int width, int height, int channels)
+{
+    if (channels == 1) return BLOCK_BC4;
+    if (channels == 2) return BLOCK_BC5;
+    if (channels == 4) {
+        for (size_t i = 0, n = (size_t)width * height; i < n; i++)
+            if (rgba[i * 4 + 3] != 255) return BLOCK_BC3;
+    }
+    return BLOCK_BC1;
+}
+
+CompressedTexture Compress(const unsigned char* rgba, int width, int height, BlockFormat format, bool flippedY)
+{
+    CompressedTexture texture;
+    texture.format = format;
+    texture.width = width;
+    texture.height = height;
+    texture.flippedY = flippedY;
+
+    std::vector<unsigned char> level(rgba, rgba + (size_t)width * height * 4);
+    int w = width, h = height;
+    for (;;) {
+        texture.levels.push_back(CompressLevel(level.data(), w, h, format));
+        if (w == 1 && h == 1) break;
+        level = Downsample(level, w, h);
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    return texture;
+}
+
+bool WriteKtx2(const std::string& path, const CompressedTexture& texture)
+{
+    uint32_t levelCount = (uint32_t)texture.levels.size();
+    std::vector<unsigned char> dfd = BuildDfd(texture.format);
+    std::vector<unsigned char> kvd;
+    PutKeyValue(kvd, "KTXorientation", texture.flippedY ? "ru" : "rd");
+    PutKeyValue(kvd, "KTXwriter", "wspinaczka_texconv");
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)texture.sourceHash);
+    PutKeyValue(kvd, "wspinaczkaSourceHash", hash);
+
+    Ktx2Header header = {};
+    std::memcpy(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+    header.vkFormat = VK_FORMATS[texture.format];
+    header.typeSize = 1;
+    header.pixelWidth = (uint32_t)texture.width;
+    header.pixelHeight = (uint32_t)texture.height;
+    header.faceCount = 1;
+    header.levelCount = levelCount;
+    header.dfdByteOffset = (uint32_t)(sizeof(Ktx2Header) + levelCount * sizeof(Ktx2Level));
+    header.dfdByteLength = (uint32_t)dfd.size();
+    header.kvdByteOffset = header.dfdByteOffset + header.dfdByteLength;
+    header.kvdByteLength = (uint32_t)kvd.size();
+
+    // Dane poziomów od najmniejszego, każdy wyrównany do rozmiaru bloku
+    size_t alignment = (size_t)BlockBytes(texture.format);
+    std::vector<Ktx2Level> index(levelCount);
+    size_t offset = Align(header.kvdByteOffset + header.kvdByteLength, alignment);
+    size_t dataStart = offset;
+    for (int i = (int)levelCount - 1; i >= 0; i--) {
+        offset = Align(offset, alignment);
+        index[i].byteOffset = offset;
+        index[i].byteLength = texture.levels[i].size();
+        index[i].uncompressedByteLength = texture.levels[i].size();
+        offset += texture.levels[i].size();
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cout << "ERROR::KTX2::CANNOT_WRITE " << path << std::endl;
+        return false;
+    }
+    const char zeros[16] = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(Ktx2Level));
+    out.write(reinterpret_cast<const char*>(dfd.data()), dfd.size());
+    out.write(reinterpret_cast<const char*>(kvd.data()), kvd.size());
+    size_t written = header.kvdByteOffset + header.kvdByteLength;
+    out.write(zeros, dataStart - written);
+    written = dataStart;
+    for (int i = (int)levelCount - 1; i >= 0; i--) {
+        out.write(zeros, index[i].byteOffset - written);
+        out.write(reinterpret_cast<const char*>(texture.levels[i].data()), texture.levels[i].size());
+        written = index[i].byteOffset + index[i].byteLength;
+    }
+    if (!out) {
+        std::cout << "ERROR::KTX2::CANNOT_WRITE " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ReadKtx2(const std::string& path, const unsigned char* data, size_t size, CompressedTexture& texture)
+{
+    Ktx2Header header;
+    if (size < sizeof(header)) {
+        std::cout << "ERROR::KTX2::INVALID_FILE " << path << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    int format = 0;
+    while (format < BLOCK_FORMAT_COUNT && VK_FORMATS[format] != header.vkFormat) format++;
+    bool supported = std::memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0
+        && format < BLOCK_FORMAT_COUNT && header.pixelDepth == 0 && header.layerCount <= 1
+        && header.faceCount == 1 && header.supercompressionScheme == 0
+        && header.pixelWidth > 0 && header.pixelHeight > 0
+        && header.levelCount > 0 && header.levelCount <= 32
+        && sizeof(header) + header.levelCount * sizeof(Ktx2Level) <= size
+        && (uint64_t)header.kvdByteOffset + header.kvdByteLength <= size;
+    if (!supported) {
+        std::cout << "ERROR::KTX2::UNSUPPORTED_FILE " << path << std::endl;
+        return false;
+    }
+
+    CompressedTexture result;
+    result.format = (BlockFormat)format;
+    result.width = (int)header.pixelWidth;
+    result.height = (int)header.pixelHeight;
+    result.flippedY = FindKeyValue(data + header.kvdByteOffset, header.kvdByteLength, "KTXorientation") == "ru";
+    std::string hash = FindKeyValue(data + header.kvdByteOffset, header.kvdByteLength, "wspinaczkaSourceHash");
+    result.sourceHash = std::strtoull(hash.c_str(), nullptr, 16);
+    result.levels.resize(header.levelCount);
+
+    for (uint32_t i = 0; i < header.levelCount; i++) {
+        Ktx2Level level;
+        std::memcpy(&level, data + sizeof(header) + i * sizeof(Ktx2Level), sizeof(level));
+        size_t expected = LevelBytes(result.format, std::max(1, result.width >> i), std::max(1, result.height >> i));
+        if (level.byteLength != expected || level.byteOffset > size || level.byteLength > size - level.byteOffset) {
+            std::cout << "ERROR::KTX2::INVALID_FILE " << path << std::endl;
+            return false;
+        }
+        const unsigned char* levelData = data + level.byteOffset;
+        result.levels[i].assign(levelData, levelData + level.byteLength);
+    }
+
+    texture = std::move(result);
+    return true;
+}
+
+}
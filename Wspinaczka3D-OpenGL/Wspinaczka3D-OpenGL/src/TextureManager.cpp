@@ -0,0 +1,785 @@
+#include "TextureManager.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "stb_image.h"
+#include "Vfs.h"
+#include "AssetPath.h"
+
+// Rozszerzenia spoza rdzenia 3.3 - GLAD generowany bez nich
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#define GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX 0x9047
+#define GL_TEXTURE_FREE_MEMORY_ATI 0x87FC
+
+namespace {
+    // Tekstura niewidziana przez tyle klatek przestaje mieć pierwszeństwo (ok. 2 s przy 60 FPS)
+    const unsigned int STALE_FRAMES = 120;
+
+    bool HasExtension(const char* name)
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++) {
+            const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (ext && std::strcmp(ext, name) == 0) return true;
+        }
+        return false;
+    }
+
+    GLenum CompressedFormat(BlockFormat format)
+    {
+        switch (format) {
+        case BLOCK_BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case BLOCK_BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case BLOCK_BC4: return GL_COMPRESSED_RED_RGTC1;
+        default:        return GL_COMPRESSED_RG_RGTC2;
+        }
+    }
+
+    GLenum PixelFormat(int channels)
+    {
+        if (channels == 1) return GL_RED;
+        if (channels == 2) return GL_RG;
+        if (channels == 4) return GL_RGBA;
+        return GL_RGB;
+    }
+
+    const char* PixelFormatName(int channels)
+    {
+        static const char* names[5] = { "", "R8", "RG8", "RGB8", "RGBA8" };
+        return names[std::min(std::max(channels, 0), 4)];
+    }
+
+    // RGB sterowniki trzymają zwykle jako RGBA
+    size_t GpuPixelBytes(int channels)
+    {
+        return channels == 3 ? 4 : (size_t)channels;
+    }
+
+    void SetSamplingParams()
+    {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+
+    double Seconds()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Karta podaje swoją pamięć tylko przez rozszerzenia producentów; bez nich stały limit
+    size_t DefaultStreamBudget()
+    {
+        GLint kb[4] = {};
+        if (HasExtension("GL_NVX_gpu_memory_info")) glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, kb);
+        else if (HasExtension("GL_ATI_meminfo")) glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, kb);
+
+        size_t budget = (size_t)256 << 20;
+        if (kb[0] > 0) budget = std::min(budget, (size_t)kb[0] * 1024 / 4); // ćwierć pamięci karty
+        return budget;
+    }
+}
+
+// =====================
+// Zdekodowany obraz
+// =====================
+
+DecodedImage::DecodedImage(DecodedImage&& other) noexcept
+    : width(other.width), height(other.height), channels(other.channels), pixels(other.pixels),
+    compressed(std::move(other.compressed))
+{
+    other.pixels = nullptr;
+}
+
+DecodedImage& DecodedImage::operator=(DecodedImage&& other) noexcept
+{
+    if (this != &other) {
+        stbi_image_free(pixels);
+        width = other.width;
+        height = other.height;
+        channels = other.channels;
+        pixels = other.pixels;
+        other.pixels = nullptr;
+        compressed = std::move(other.compressed);
+    }
+    return *this;
+}
+
+DecodedImage::~DecodedImage()
+{
+    stbi_image_free(pixels);
+}
+
+DecodedImage DecodedImage::Decode(const std::string& path, bool flipVertically)
+{
+    DecodedImage image;
+
+    // Gotowa wersja skompresowana - tylko z obecnej zawartości obrazu (bez obrazu nie ma czego sprawdzać),
+    // w tej samej orientacji i w formacie, który karta obsługuje
+    FileView file = Vfs::Open(path);
+    CompressedTexture compressed;
+    FileView ktx2 = Vfs::Open(path + ".ktx2");
+    if (ktx2.Valid() && TextureCompression::ReadKtx2(path + ".ktx2", ktx2.Data(), ktx2.Size(), compressed)) {
+        if (file.Valid() && compressed.sourceHash != Fnv1a(file.Data(), file.Size()))
+            std::cout << "ERROR::TEXTURE::KTX2_STALE " << path << ".ktx2" << std::endl;
+        else if (compressed.flippedY != flipVertically)
+            std::cout << "ERROR::TEXTURE::KTX2_ORIENTATION " << path << ".ktx2" << std::endl;
+        else if (TextureManager::SupportsFormat(compressed.format)) {
+            image.width = compressed.width;
+            image.height = compressed.height;
+            image.channels = compressed.format == BLOCK_BC4 ? 1 : compressed.format == BLOCK_BC5 ? 2
+                : compressed.format == BLOCK_BC3 ? 4 : 3;
+            image.compressed = std::move(compressed);
+            return image;
+        }
+    }
+
+    // Ustawienie tylko dla bieżącego wątku - dekodery AssetLoader działają równolegle
+    stbi_set_flip_vertically_on_load_thread(flipVertically);
+    if (file.Valid())
+        image.pixels = stbi_load_from_memory(file.Data(), (int)file.Size(), &image.width, &image.height, &image.channels, 0);
+    return image;
+}
+
+// =====================
+// Uchwyt
+// =====================
+
+TextureHandle::TextureHandle(const TextureHandle& other) : id(other.id)
+{
+    if (id) TextureManager::Instance().addRef(id);
+}
+
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept : id(other.id)
+{
+    other.id = 0;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle other)
+{
+    std::swap(id, other.id);
+    return *this;
+}
+
+TextureHandle::~TextureHandle()
+{
+    Reset();
+}
+
+void TextureHandle::Reset()
+{
+    if (id) TextureManager::Instance().Release(id);
+    id = 0;
+}
+
+// =====================
+// Menedżer
+// =====================
+
+TextureManager& TextureManager::Instance()
+{
+    static TextureManager instance;
+    return instance;
+}
+
+unsigned int TextureManager::supportedFormats = 0;
+
+TextureManager::~TextureManager()
+{
+    stopStreaming();
+}
+
+void TextureManager::DetectCompression()
+{
+    supportedFormats = (1u << BLOCK_BC4) | (1u << BLOCK_BC5); // RGTC jest w rdzeniu od 3.0
+    if (HasExtension("GL_EXT_texture_compression_s3tc"))
+        supportedFormats |= (1u << BLOCK_BC1) | (1u << BLOCK_BC3);
+}
+
+bool TextureManager::SupportsFormat(BlockFormat format)
+{
+    return (supportedFormats >> format) & 1u;
+}
+
+TextureHandle TextureManager::Load(const std::string& path, bool stream)
+{
+    return TextureHandle(Acquire(path, stream));
+}
+
+unsigned int TextureManager::Acquire(const std::string& path, bool stream)
+{
+    std::string normalized = AssetPath::Normalize(path);
+    uint64_t key = AssetPath::Hash(normalized);
+
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        it->second.refs++;
+        return it->second.id;
+    }
+
+    if (streaming && stream) {
+        insertStreamed(key, normalized, 1);
+        return entries[key].id;
+    }
+
+    DecodedImage image = DecodedImage::Decode(normalized);
+    if (!image.Valid()) {
+        std::cout << "ERROR::TEXTURE::LOAD_FAILED " << normalized << std::endl;
+        return 0;
+    }
+    insert(key, normalized, image, 1);
+    return entries[key].id;
+}
+
+void TextureManager::Preload(const std::string& path, const DecodedImage& image)
+{
+    std::string normalized = AssetPath::Normalize(path);
+    uint64_t key = AssetPath::Hash(normalized);
+    if (entries.count(key)) return;
+    if (!image.Valid()) {
+        std::cout << "ERROR::TEXTURE::LOAD_FAILED " << normalized << std::endl;
+        return;
+    }
+    insert(key, normalized, image, 0);
+}
+
+void TextureManager::addRef(unsigned int id)
+{
+    auto key = keyById.find(id);
+    if (key != keyById.end()) entries[key->second].refs++;
+}
+
+void TextureManager::Release(unsigned int id)
+{
+    if (shutDown || id == 0) return;
+    auto key = keyById.find(id);
+    if (key == keyById.end()) return;
+
+    Entry& entry = entries[key->second];
+    if (--entry.refs > 0) return;
+
+    glDeleteTextures(1, &entry.id);
+    memoryBytes -= entry.bytes;
+    if (entry.streamed) streamedBytes -= entry.bytes;
+    entries.erase(key->second);
+    keyById.erase(key);
+}
+
+void TextureManager::Shutdown()
+{
+    stopStreaming();
+    for (auto& e : entries) glDeleteTextures(1, &e.second.id);
+    if (uploadPBO) glDeleteBuffers(1, &uploadPBO);
+    uploadPBO = 0;
+    entries.clear();
+    keyById.clear();
+    memoryBytes = 0;
+    streamedBytes = 0;
+    shutDown = true;
+}
+
+void TextureManager::PrintReport() const
+{
+    std::cout << "Tekstury: " << entries.size() << ", pamiec GPU: "
+        << memoryBytes / (1024.0 * 1024.0) << " MB";
+    if (streaming)
+        std::cout << " (strumieniowane " << streamedBytes / (1024.0 * 1024.0) << " / "
+            << streamSettings.budgetBytes / (1024.0 * 1024.0) << " MB)";
+    std::cout << std::endl;
+    for (const auto& e : entries) {
+        const Entry& t = e.second;
+        std::cout << "  " << t.path << " " << t.width << "x" << t.height << " " << t.format
+            << " " << t.bytes / 1024 << " KB, uzycia: " << t.refs;
+        if (t.streamed && t.residentLevel < t.levelCount)
+            std::cout << ", na GPU od " << std::max(1, t.width >> t.residentLevel) << "x"
+                << std::max(1, t.height >> t.residentLevel);
+        else if (t.streamed)
+            std::cout << ", na GPU tylko teksel 1x1";
+        std::cout << std::endl;
+    }
+}
+
+const void* TextureManager::stage(const void* data, size_t size)
+{
+    if (!uploadPBO) glGenBuffers(1, &uploadPBO);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, uploadPBO);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+    // Z PBO glTex(Sub)Image wraca od razu, a kopiowanie do tekstury robi już sterownik
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped) {
+        std::memcpy(mapped, data, size);
+        if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) return nullptr; // offset 0 w PBO
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return data;
+}
+
+void TextureManager::UploadImage(unsigned int target, const DecodedImage& image)
+{
+    if (image.compressed.Valid()) {
+        const CompressedTexture& c = image.compressed;
+        if (!uploadPBO) glGenBuffers(1, &uploadPBO);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, uploadPBO);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, c.Bytes(), nullptr, GL_STREAM_DRAW);
+
+        // Wszystkie poziomy jednym kopiowaniem do PBO, potem glCompressedTexImage2D z przesunięć
+        unsigned char* mapped = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, c.Bytes(),
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+        bool fromPBO = false;
+        if (mapped) {
+            size_t offset = 0;
+            for (const auto& level : c.levels) {
+                std::memcpy(mapped + offset, level.data(), level.size());
+                offset += level.size();
+            }
+            fromPBO = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+        }
+        if (!fromPBO) glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        size_t offset = 0;
+        for (size_t i = 0; i < c.levels.size(); i++) {
+            const void* data = fromPBO ? (const void*)offset : (const void*)c.levels[i].data();
+            glCompressedTexImage2D(target, (GLint)i, CompressedFormat(c.format),
+                std::max(1, c.width >> i), std::max(1, c.height >> i), 0, (GLsizei)c.levels[i].size(), data);
+            offset += c.levels[i].size();
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return;
+    }
+
+    GLenum format = PixelFormat(image.channels);
+    const void* source = stage(image.pixels, image.Bytes());
+
+    // Wiersze RGB nie muszą mieć długości podzielnej przez 4
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(target, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, source);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureManager::insert(uint64_t key, const std::string& path, const DecodedImage& image, int refs)
+{
+    Entry entry;
+    entry.path = path;
+    entry.refs = refs;
+    entry.width = image.width;
+    entry.height = image.height;
+
+    glGenTextures(1, &entry.id);
+    glBindTexture(GL_TEXTURE_2D, entry.id);
+    UploadImage(GL_TEXTURE_2D, image);
+    if (image.compressed.Valid()) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)image.compressed.levels.size() - 1);
+        entry.format = TextureCompression::FormatName(image.compressed.format);
+    }
+    else {
+        glGenerateMipmap(GL_TEXTURE_2D);
+        entry.format = PixelFormatName(image.channels);
+    }
+    SetSamplingParams();
+
+    // Poziom 0 + łańcuch mipmap (ok. 1/3 więcej)
+    entry.bytes = image.compressed.Valid() ? image.compressed.Bytes()
+        : (size_t)entry.width * entry.height * GpuPixelBytes(image.channels) * 4 / 3;
+
+    memoryBytes += entry.bytes;
+    keyById[entry.id] = key;
+    entries[key] = std::move(entry);
+}
+
+// =====================
+// Strumieniowanie
+// =====================
+
+void TextureManager::EnableStreaming(const TextureStreamSettings& settings)
+{
+    if (streaming) return;
+    streamSettings = settings;
+    if (streamSettings.budgetBytes == 0) streamSettings.budgetBytes = DefaultStreamBudget();
+
+    int threads = settings.workerThreads;
+    if (threads <= 0) threads = std::max(1, std::min(4, (int)std::thread::hardware_concurrency() / 2));
+    streamStopping = false;
+    for (int i = 0; i < threads; i++)
+        streamWorkers.emplace_back(&TextureManager::streamWorkerLoop, this);
+
+    streaming = true;
+    streamStartTime = Seconds();
+}
+
+void TextureManager::stopStreaming()
+{
+    {
+        std::lock_guard<std::mutex> lock(streamMutex);
+        streamStopping = true;
+        streamJobs.clear();
+    }
+    streamReady.notify_all();
+    for (std::thread& worker : streamWorkers) worker.join();
+    streamWorkers.clear();
+    streamResults.clear();
+    decodesInFlight = 0;
+}
+
+void TextureManager::streamWorkerLoop()
+{
+    for (;;) {
+        StreamJob job;
+        {
+            std::unique_lock<std::mutex> lock(streamMutex);
+            streamReady.wait(lock, [this] { return streamStopping || !streamJobs.empty(); });
+            if (streamStopping) return;
+            job = std::move(streamJobs.front());
+            streamJobs.pop_front();
+        }
+
+        DecodedImage image = DecodedImage::Decode(job.path);
+        StreamResult result;
+        result.key = job.key;
+        if (image.Valid()) result.source = buildSource(image);
+
+        std::lock_guard<std::mutex> lock(streamMutex);
+        streamResults.push_back(std::move(result));
+    }
+}
+
+std::unique_ptr<TextureManager::StreamSource> TextureManager::buildSource(DecodedImage& image)
+{
+    auto source = std::make_unique<StreamSource>();
+    source->width = image.width;
+    source->height = image.height;
+    source->channels = image.channels;
+
+    if (image.compressed.Valid()) {
+        source->compressed = true;
+        source->format = image.compressed.format;
+        source->levels = std::move(image.compressed.levels);
+        return source;
+    }
+
+    // Mipmapy liczone tutaj (średnia 2x2) - glGenerateMipmap potrzebowałby pełnego poziomu na GPU
+    int c = image.channels, w = image.width, h = image.height;
+    source->levels.emplace_back(image.pixels, image.pixels + (size_t)w * h * c);
+    while (w > 1 || h > 1) {
+        int nw = std::max(1, w / 2), nh = std::max(1, h / 2);
+        const std::vector<unsigned char>& src = source->levels.back();
+        std::vector<unsigned char> dst((size_t)nw * nh * c);
+        for (int y = 0; y < nh; y++) {
+            int y0 = std::min(2 * y, h - 1), y1 = std::min(2 * y + 1, h - 1);
+            for (int x = 0; x < nw; x++) {
+                int x0 = std::min(2 * x, w - 1), x1 = std::min(2 * x + 1, w - 1);
+                for (int k = 0; k < c; k++) {
+                    int sum = src[((size_t)y0 * w + x0) * c + k] + src[((size_t)y0 * w + x1) * c + k]
+                        + src[((size_t)y1 * w + x0) * c + k] + src[((size_t)y1 * w + x1) * c + k];
+                    dst[((size_t)y * nw + x) * c + k] = (unsigned char)((sum + 2) / 4);
+                }
+            }
+        }
+        source->levels.push_back(std::move(dst));
+        w = nw;
+        h = nh;
+    }
+    return source;
+}
+
+void TextureManager::insertStreamed(uint64_t key, const std::string& path, int refs)
+{
+    Entry entry;
+    entry.path = path;
+    entry.refs = refs;
+    entry.streamed = true;
+
+    // Szary teksel na poziomie 0, dopóki nie przyjdą mipmapy z pliku
+    const unsigned char grey[4] = { 128, 128, 128, 255 };
+    glGenTextures(1, &entry.id);
+    glBindTexture(GL_TEXTURE_2D, entry.id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    SetSamplingParams();
+
+    keyById[entry.id] = key;
+    entries[key] = std::move(entry);
+}
+
+void TextureManager::Touch(unsigned int id, float distance)
+{
+    if (!streaming || id == 0) return;
+    auto key = keyById.find(id);
+    if (key == keyById.end()) return;
+
+    Entry& entry = entries[key->second];
+    if (entry.touchFrame != frame) {
+        entry.touchFrame = frame;
+        entry.distance = distance;
+    }
+    else {
+        entry.distance = std::min(entry.distance, distance);
+    }
+}
+
+void TextureManager::receiveSource(Entry& entry, std::unique_ptr<StreamSource> source)
+{
+    if (!source) {
+        std::cout << "ERROR::TEXTURE::LOAD_FAILED " << entry.path << std::endl;
+        entry.failed = true;
+        return;
+    }
+
+    // Rozmiary poziomów znane od pierwszego wczytania - później plik jest czytany tylko ponownie
+    if (entry.levelCount == 0) {
+        entry.width = source->width;
+        entry.height = source->height;
+        entry.format = source->compressed ? TextureCompression::FormatName(source->format)
+            : PixelFormatName(source->channels);
+        entry.levelCount = (int)source->levels.size();
+        entry.residentLevel = entry.levelCount;
+        entry.lowLevel = entry.levelCount - 1;
+        for (int i = 0; i < entry.levelCount; i++) {
+            int w = std::max(1, entry.width >> i), h = std::max(1, entry.height >> i);
+            entry.levelBytes.push_back(source->compressed ? source->levels[i].size()
+                : (size_t)w * h * GpuPixelBytes(source->channels));
+            if (std::max(w, h) <= streamSettings.lowMipSize) entry.lowLevel = std::min(entry.lowLevel, i);
+        }
+    }
+    entry.source = std::move(source);
+}
+
+void TextureManager::uploadLevel(const StreamSource& source, int level)
+{
+    const std::vector<unsigned char>& data = source.levels[level];
+    int w = std::max(1, source.width >> level), h = std::max(1, source.height >> level);
+    const void* pixels = stage(data.data(), data.size());
+
+    if (source.compressed) {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, CompressedFormat(source.format), w, h, 0,
+            (GLsizei)data.size(), pixels);
+    }
+    else {
+        GLenum format = PixelFormat(source.channels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, level, format, w, h, 0, format, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureManager::allocateLevel(const StreamSource& source, int level)
+{
+    int w = std::max(1, source.width >> level), h = std::max(1, source.height >> level);
+    if (source.compressed) {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, CompressedFormat(source.format), w, h, 0,
+            (GLsizei)source.levels[level].size(), nullptr);
+    }
+    else {
+        GLenum format = PixelFormat(source.channels);
+        glTexImage2D(GL_TEXTURE_2D, level, format, w, h, 0, format, GL_UNSIGNED_BYTE, nullptr);
+    }
+}
+
+int TextureManager::uploadRows(const StreamSource& source, int level, int firstRow, size_t maxBytes, size_t& bytes)
+{
+    const std::vector<unsigned char>& data = source.levels[level];
+    int w = std::max(1, source.width >> level), h = std::max(1, source.height >> level);
+
+    // Formaty blokowe: wiersz = rząd bloków 4x4
+    int rowHeight = source.compressed ? 4 : 1;
+    size_t rowBytes = source.compressed
+        ? (size_t)((w + 3) / 4) * TextureCompression::BlockBytes(source.format)
+        : (size_t)w * source.channels;
+    int totalRows = (h + rowHeight - 1) / rowHeight;
+    int first = firstRow / rowHeight;
+    int rows = std::min(totalRows - first, std::max(1, (int)(maxBytes / rowBytes)));
+
+    size_t size = (size_t)rows * rowBytes;
+    const void* pixels = stage(data.data() + (size_t)first * rowBytes, size);
+    int y = first * rowHeight;
+    int height = std::min(rows * rowHeight, h - y);
+    if (source.compressed) {
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, y, w, height, CompressedFormat(source.format),
+            (GLsizei)size, pixels);
+    }
+    else {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, y, w, height, PixelFormat(source.channels), GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    bytes += size;
+    return height;
+}
+
+void TextureManager::discardPending(Entry& entry)
+{
+    int level = entry.residentLevel - 1;
+    glBindTexture(GL_TEXTURE_2D, entry.id);
+    glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    entry.pendingRows = 0;
+    entry.bytes -= entry.levelBytes[level];
+    memoryBytes -= entry.levelBytes[level];
+    streamedBytes -= entry.levelBytes[level];
+}
+
+void TextureManager::dropLevel(Entry& entry)
+{
+    if (entry.pendingRows > 0) discardPending(entry);
+    int level = entry.residentLevel;
+    glBindTexture(GL_TEXTURE_2D, entry.id);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level + 1);
+    // Poziom poniżej bazy nie jest próbkowany - pusty obraz oddaje jego pamięć
+    glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    entry.residentLevel++;
+    entry.bytes -= entry.levelBytes[level];
+    memoryBytes -= entry.levelBytes[level];
+    streamedBytes -= entry.levelBytes[level];
+}
+
+bool TextureManager::makeRoom(size_t bytes, const std::vector<Entry*>& order)
+{
+    size_t budget = streamSettings.budgetBytes;
+    for (auto it = order.rbegin(); it != order.rend() && streamedBytes + bytes > budget; ++it) {
+        Entry& victim = **it;
+        while (victim.residentLevel < victim.targetLevel && streamedBytes + bytes > budget)
+            dropLevel(victim);
+    }
+    return streamedBytes + bytes <= budget;
+}
+
+void TextureManager::Update()
+{
+    if (!streaming || shutDown) return;
+
+    std::vector<StreamResult> ready;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex);
+        ready.swap(streamResults);
+    }
+    for (StreamResult& result : ready) {
+        decodesInFlight--;
+        auto it = entries.find(result.key);
+        if (it == entries.end() || !it->second.streamed) continue; // tekstura zwolniona w międzyczasie
+        it->second.decoding = false;
+        receiveSource(it->second, std::move(result.source));
+    }
+
+    // Najbliższe kamerze najpierw; dawno niewidziane (albo wcale) na końcu
+    std::vector<Entry*> order;
+    for (auto& e : entries)
+        if (e.second.streamed && !e.second.failed) order.push_back(&e.second);
+    auto priority = [this](const Entry* e) {
+        return (e->touchFrame && frame - e->touchFrame <= STALE_FRAMES) ? e->distance : FLT_MAX;
+    };
+    std::sort(order.begin(), order.end(),
+        [&priority](const Entry* a, const Entry* b) { return priority(a) < priority(b); });
+
+    // Budżet rozdawany po kolei: każda tekstura tyle poziomów, ile potrzebuje z odległości
+    // i ile się zmieści (małe mipmapy zawsze)
+    size_t remaining = streamSettings.budgetBytes;
+    for (Entry* e : order) {
+        if (e->levelCount == 0) continue;
+        float distance = priority(e);
+        int wanted = e->lowLevel;
+        if (distance < FLT_MAX) {
+            float steps = std::ceil(std::log2(std::max(distance / streamSettings.fullDetailDistance, 1.0f)));
+            wanted = std::min(e->lowLevel, (int)steps);
+        }
+
+        int level = e->lowLevel;
+        size_t cost = 0;
+        for (int i = level; i < e->levelCount; i++) cost += e->levelBytes[i];
+        while (level > wanted && cost + e->levelBytes[level - 1] <= remaining) cost += e->levelBytes[--level];
+        e->targetLevel = level;
+        remaining -= std::min(cost, remaining);
+    }
+
+    // Kolejne poziomy na GPU, od najmniejszych; miejsce robią tekstury trzymające więcej niż ich cel.
+    // Poziom staje się bazą dopiero, gdy jest cały - do tego czasu próbkowany jest poprzedni.
+    size_t uploaded = 0, perFrame = streamSettings.uploadBytesPerFrame;
+    for (Entry* e : order) {
+        if (e->pendingRows > 0 && e->residentLevel <= e->targetLevel) discardPending(*e);
+
+        while (e->source && e->residentLevel > e->targetLevel && uploaded < perFrame) {
+            if (e->residentLevel == e->levelCount) {
+                // Małe mipmapy naraz i zawsze, nawet ponad budżet
+                size_t bytes = 0;
+                for (int i = e->lowLevel; i < e->levelCount; i++) bytes += e->levelBytes[i];
+                makeRoom(bytes, order);
+
+                glBindTexture(GL_TEXTURE_2D, e->id);
+                for (int i = e->levelCount - 1; i >= e->lowLevel; i--) uploadLevel(*e->source, i);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, e->levelCount - 1);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, e->lowLevel);
+
+                e->residentLevel = e->lowLevel;
+                e->bytes += bytes;
+                memoryBytes += bytes;
+                streamedBytes += bytes;
+                uploaded += bytes;
+                continue;
+            }
+
+            int level = e->residentLevel - 1;
+            if (e->pendingRows == 0) {
+                if (!makeRoom(e->levelBytes[level], order)) break;
+                glBindTexture(GL_TEXTURE_2D, e->id);
+                allocateLevel(*e->source, level);
+                e->bytes += e->levelBytes[level];
+                memoryBytes += e->levelBytes[level];
+                streamedBytes += e->levelBytes[level];
+            }
+            glBindTexture(GL_TEXTURE_2D, e->id);
+            e->pendingRows += uploadRows(*e->source, level, e->pendingRows, perFrame - uploaded, uploaded);
+            if (e->pendingRows >= std::max(1, e->height >> level)) {
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+                e->residentLevel = level;
+                e->pendingRows = 0;
+            }
+        }
+        // Cel osiągnięty - łańcuch w RAM niepotrzebny (gdy zabraknie poziomów, plik zostanie wczytany ponownie)
+        if (e->source && e->residentLevel <= e->targetLevel) e->source.reset();
+    }
+
+    // Dekodowanie tego, czego brakuje - najwyżej jeden plik na wątek, żeby kolejność nadążała za kamerą
+    for (Entry* e : order) {
+        if (decodesInFlight >= (int)streamWorkers.size()) break;
+        bool needsData = e->residentLevel == e->levelCount || e->residentLevel > e->targetLevel;
+        if (!needsData || e->source || e->decoding) continue;
+
+        e->decoding = true;
+        decodesInFlight++;
+        {
+            std::lock_guard<std::mutex> lock(streamMutex);
+            streamJobs.push_back({ AssetPath::Hash(e->path), e->path });
+        }
+        streamReady.notify_one();
+    }
+
+#ifdef _DEBUG
+    // Czas strumieniowania i raport tylko w Debug; w grze PrintReport na żądanie
+    if (!streamIdleReported && decodesInFlight == 0 && !order.empty()) {
+        bool idle = true;
+        for (const Entry* e : order)
+            if (e->residentLevel == e->levelCount || e->residentLevel > e->targetLevel) idle = false;
+        if (idle) {
+            std::cout << "Strumieniowanie tekstur zakonczone po " << Seconds() - streamStartTime << " s" << std::endl;
+            PrintReport();
+            streamIdleReported = true;
+        }
+    }
+#endif
+    frame++;
+}
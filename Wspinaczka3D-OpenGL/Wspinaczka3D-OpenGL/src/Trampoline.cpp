@@ -1,37 +1,15 @@
 #include "Trampoline.h"
-#include <glm/gtc/matrix_transform.hpp>
 
 // Konstruktor
-Trampoline::Trampoline(glm::vec3 pos, float r, float h, float force, Model* modelRef, glm::vec3 scale, glm::vec3 offset) {
+Trampoline::Trampoline(glm::vec3 pos, float r, float h, float force, glm::vec3 scale, glm::vec3 offset) {
     position = pos;
     radius = r;
     height = h;
     bounceForce = force;
-    model = modelRef;
     visualScale = scale;
     visualOffset = offset;
 }
 
-// Rysowanie
-void Trampoline::Draw(Shader& shader) {
-    shader.setInt("useTexture", 1);
-    shader.setVec4("objectColor", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
-
-    glm::mat4 modelMatrix = glm::mat4(1.0f);
-
-    // Przesu na pozycj w wiecie
-    modelMatrix = glm::translate(modelMatrix, position);
-
-    // 2. Zastosuj korekt przesunicia
-    modelMatrix = glm::translate(modelMatrix, visualOffset);
-
-    // 3. Zastosuj skalowanie
-    modelMatrix = glm::scale(modelMatrix, visualScale);
-
-    shader.setMat4("model", modelMatrix);
-    model->Draw(shader);
-}
-
 // Sprawdzanie kolizji
 bool Trampoline::checkCollision(glm::vec3 playerPos, float& playerY, float& velocityY, float playerHalfHeight) {
     float footLevel = playerPos.y - playerHalfHeight;
@@ -0,0 +1,25 @@
+#include "Trampoline.h"
+#include "Model.h"
+#include "RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+// Rysowanie
+void Trampoline::Submit(RenderQueue& queue, Model& model) {
+    // Płótno widać z obu stron, oświetlone zawsze jak powierzchnia skierowana w górę
+    DrawState state;
+    state.twoSided = true;
+    state.forceUpNormal = true;
+
+    glm::mat4 modelMatrix = glm::mat4(1.0f);
+
+    // Przesuń na pozycję w świecie
+    modelMatrix = glm::translate(modelMatrix, position);
+
+    // 2. Zastosuj korektę przesunięcia
+    modelMatrix = glm::translate(modelMatrix, visualOffset);
+
+    // 3. Zastosuj skalowanie
+    modelMatrix = glm::scale(modelMatrix, visualScale);
+
+    queue.Submit(model, modelMatrix, state);
+}
@@ -0,0 +1,46 @@
+#include "Vfs.h"
+#include "AssetPack.h"
+
+namespace {
+
+AssetPack pack;
+bool looseFirst = false;
+
+FileView OpenLoose(const std::string& path) {
+    std::unique_ptr<MappedFile> file(new MappedFile(path));
+    if (!file->IsOpen()) return FileView();
+    return FileView(std::move(file));
+}
+
+FileView OpenPacked(const std::string& path) {
+    size_t size = 0;
+    const unsigned char* data = pack.Find(path, size);
+    return data ? FileView(data, size) : FileView();
+}
+
+}
+
+namespace Vfs {
+
+bool Mount(const std::string& packPath, bool looseOverride) {
+    looseFirst = looseOverride;
+    return pack.Open(packPath);
+}
+
+void Unmount() {
+    pack.Close();
+}
+
+FileView Open(const std::string& path) {
+    if (looseFirst) {
+        FileView view = OpenLoose(path);
+        if (view.Valid()) return view;
+        return OpenPacked(path);
+    }
+    // Z paczki bez dotykania dysku; luźne pliki tylko dla tego, czego w niej nie ma
+    FileView view = OpenPacked(path);
+    if (view.Valid()) return view;
+    return OpenLoose(path);
+}
+
+}
@@ -0,0 +1,13 @@
+#include "WinZone.h"
+#include "Model.h"
+#include "RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+void WinZone::Submit(RenderQueue& queue, Model& rampModel) {
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, glm::vec3(20.0f, 2.05f, 0.0f));
+    model = glm::rotate(model, glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    DrawState state;
+    state.staticCaster = true;
+    queue.Submit(rampModel, model, state);
+}
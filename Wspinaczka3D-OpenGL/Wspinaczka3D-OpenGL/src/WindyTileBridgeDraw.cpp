@@ -0,0 +1,81 @@
+#include "WindyTileBridge.h"
+#include "Model.h"
+#include "RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+// Kolor kafelka zależny od czasu stania (zielony -> żółty -> czerwony, miganie przed zniknięciem)
+static glm::vec4 TileColor(const WindyTile& tile, float timer) {
+    glm::vec4 color;
+    if (tile.isEndTile) {
+        // Fioletowe kafelki mety (zielony + czerwony = fioletowy)
+        color = glm::vec4(0.5f, 0.0f, 1.0f, 1.0f);
+    }
+    else {
+        // Normalny gradient czasowy
+        float timeRatio = glm::clamp(timer / tile.maxTime, 0.0f, 1.0f);
+        if (timeRatio < 0.4f) {
+            color = glm::mix(glm::vec4(0.0f, 1.0f, 0.2f, 1.0f),
+                glm::vec4(1.0f, 1.0f, 0.2f, 1.0f),
+                timeRatio * 2.5f);
+        }
+        else {
+            color = glm::mix(glm::vec4(1.0f, 1.0f, 0.2f, 1.0f),
+                glm::vec4(1.0f, 0.0f, 0.0f, 1.0f),
+                (timeRatio - 0.4f) * 1.666f);
+        }
+    }
+
+    // Miganie gdy blisko zniknięcia
+    if (timer > tile.maxTime * 0.8f) {
+        float flash = sin(timer * 15.0f) * 0.3f + 0.7f;
+        color *= flash;
+    }
+    return color;
+}
+
+void WindyTileBridge::Submit(RenderQueue& queue, Model& tileModel, InstanceBuffer& buffer) {
+    float visualSize = tileSize * 0.82f;
+    auto tileMatrix = [&](const WindyTile& tile) {
+        return glm::scale(glm::translate(glm::mat4(1.0f), tile.position), glm::vec3(visualSize, 0.5f, visualSize));
+    };
+    auto refresh = [&](int i) {
+        const WindyTile& tile = tiles[i];
+        InstanceData& inst = tileInstances[i];
+        if (tile.active) {
+            inst.SetModel(tileMatrix(tile));
+            inst.color = TileColor(tile, TileTimer(tile));
+        }
+        else {
+            // Zniknięty kafelek - zerowa macierz, trójkąty zapadają się w punkt
+            inst.model = glm::mat4(0.0f);
+            inst.normalMatrix = glm::mat3(0.0f);
+            inst.color = glm::vec4(0.0f);
+        }
+    };
+
+    int n = (int)tiles.size();
+    if ((int)tileInstances.size() != n) {
+        tileInstances.resize(n);
+        dirtyBegin = 0;
+        dirtyEnd = n;
+
+        // Kafelki się nie ruszają - granice całego mostu liczone raz
+        tileBounds = AABB();
+        for (const WindyTile& tile : tiles) tileBounds.Expand(tileModel.bounds.Transformed(tileMatrix(tile)));
+    }
+
+    for (int i = dirtyBegin; i < dirtyEnd; i++) refresh(i);
+    for (int i : warmTiles) refresh(i);
+
+    // Na GPU tylko zmieniony zakres i stygnące kafelki
+    if (buffer.capacity < n) {
+        buffer.Upload(tileInstances.data(), n);
+    }
+    else {
+        buffer.UploadRange(tileInstances.data(), dirtyBegin, dirtyEnd - dirtyBegin);
+        for (int i : warmTiles) buffer.UploadRange(tileInstances.data(), i, 1);
+    }
+    dirtyBegin = dirtyEnd = 0;
+
+    queue.SubmitInstanced(tileModel, buffer, n, DrawState(), tileBounds);
+}
@@ -0,0 +1,383 @@
+#include "World.h"
+#include <cmath>
+
+World::World()
+    : ladder(glm::vec3(23.0f, 15.0f, 27.0f), 10.0f), // Drabina (23, 15, 27)
+      maze(glm::vec3(11.0f, 15.0f, 7.0f)),
+      glassBridge(glm::vec3(25.0f, 0.0f, 0.0f), 2.85f),
+      trampoline(glm::vec3(41.0f, 0.0, 0.0f), 0.4f, 0.5f, 35.0f, glm::vec3(0.2f), glm::vec3(0.0f)),
+      wallCourse(glm::vec3(-45.0f, 23.6f, 28.0f)),
+      windyBridge(glm::vec3(-46.0f, 24.3f, 58.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 1.0f), 10, 30, 2.0f),
+      finalWinZone(glm::vec3(0.0f, 24.3f, 125.0f), 12.0f, 12.0f, 24.3f)
+{
+    platforms = {
+        { {37.5f, 40.5f, -1.5f, 1.5f, 15.0f }, glm::vec3(39.0f, 15.0f, -4.5f), glm::vec3(39.0f, 15.0f, 4.5f), 2.5f, 0.0f, 1, glm::vec3(0.0f) },
+        { {33.5f, 36.5f, -1.5f, 1.5f, 15.0f }, glm::vec3(35.0f, 15.0f, -5.0f), glm::vec3(35.0f, 15.0f, 5.0f), 4.0f, 0.2f, -1, glm::vec3(0.0f) },
+        { {29.5f, 32.5f, -1.5f, 1.5f, 15.0f }, glm::vec3(31.0f, 15.0f, -6.0f), glm::vec3(31.0f, 15.0f, 6.0f), 3.0f, 0.5f, 1, glm::vec3(0.0f) },
+        { {25.5f, 28.5f, -1.5f, 1.5f, 15.0f }, glm::vec3(27.0f, 15.0f, -4.0f), glm::vec3(27.0f, 15.0f, 4.0f), 5.5f, 0.8f, -1, glm::vec3(0.0f) }
+    };
+
+    tables = {
+        {-2.8f, -1.2f, -0.8f, 0.8f, 0.68f}, {-0.8f, 0.8f, -0.8f, 0.8f, 1.45f}, {1.7f, 3.3f, -0.8f, 0.8f, 1.45f},
+        {4.2f, 5.8f, -2.3f, -0.7f, 1.45f}, {6.7f, 8.3f, 0.7f, 2.3f, 1.45f}, {9.2f, 10.8f, -2.3f, -0.7f, 1.45f},
+        {11.7f, 13.3f, 0.7f, 2.3f, 1.45f}, {14.2f, 15.8f, -2.3f, -0.7f, 1.45f}, {17.2f, 18.8f, -0.8f, 0.8f, 1.45f},
+        {17.2f, 18.8f, 1.7f, 3.3f, 0.68f}
+    };
+
+    midSafeZone = { 43.0f, 47.0f, -2.0f, 2.0f, 15.0f };
+    mazeFloor = { 10.0f, 30.0f, 6.0f, 26.0f, 15.0f };
+    ladderPillow = { -40.5f, 28.0f, 27.8f, 33.0f, 22.9f };
+    barrierBack = { -40.5f, 28.0f, 28.1f, 28.5f, 23.6f };
+    barrierFront = { -40.5f, 28.0f, 31.6f, 32.0f, 23.6f };
+
+    BuildColliders();
+    CaptureRenderState(currentRenderState);
+    previousRenderState = currentRenderState;
+}
+
+void World::BuildColliders() {
+    // Stoły: lądowanie z obrażeniami, boki blokują
+    for (auto& tb : tables) {
+        Collider c;
+        c.box = tb;
+        c.fallDamage = true;
+        c.solidSides = true;
+        colliders.Add(c);
+    }
+
+    // Rampa przy mecie (wysokość rośnie wzdłuż X) i jej boczny hitbox
+    Collider ramp;
+    ramp.shape = Collider::RAMP_X;
+    ramp.box = { winZone.ramp.minX, winZone.ramp.maxX, winZone.ramp.minZ, winZone.ramp.maxZ, winZone.ramp.endY };
+    ramp.startY = winZone.ramp.startY;
+    ramp.endY = winZone.ramp.endY;
+    ramp.landFrom = 0.5f;
+    ramp.landTo = 0.0f;
+    ramp.fallDamage = true;
+    colliders.Add(ramp);
+
+    Collider rampSides;
+    rampSides.box = winZone.rampHorizontalBox;
+    rampSides.landable = false;
+    rampSides.solidSides = true;
+    colliders.Add(rampSides);
+
+    // Strefa za platformami, poduszka i barierki - węższe okno lądowania
+    Collider mid;
+    mid.box = midSafeZone;
+    mid.landFrom = 0.1f;
+    mid.landTo = 0.0f;
+    mid.solidSides = true;
+    colliders.Add(mid);
+
+    for (const TableHitbox* hb : { &ladderPillow, &barrierBack, &barrierFront }) {
+        Collider c;
+        c.box = *hb;
+        c.landFrom = 0.1f;
+        c.landTo = 0.0f;
+        c.solidSides = true;
+        c.sidesAboveY = 15.0f;
+        colliders.Add(c);
+    }
+
+    Collider floor;
+    floor.box = mazeFloor;
+    colliders.Add(floor);
+
+    Collider road;
+    road.box = wallCourse.GetRoadHitbox();
+    colliders.Add(road);
+
+    // Ruchome platformy przenoszą gracza
+    for (size_t i = 0; i < platforms.size(); i++) {
+        Collider c;
+        c.box = platforms[i].hitbox;
+        c.platform = (int)i;
+        platforms[i].colliderId = colliders.Add(c);
+    }
+}
+
+void World::Step(float dt, const SimInput& input) {
+    previousRenderState = currentRenderState;
+    time += dt;
+
+    wallCourse.Update(dt);
+    windyBridge.Update(dt, eggPosition);
+
+    if (needsReset) ResetRun();
+
+    bool canMove = ProcessInput(input);
+
+    float h = dt / (float)glm::max(substeps, 1);
+    for (int s = 0; s < substeps && currentState == GAME_STATE_PLAYING; s++) {
+        previousEggPosition = eggPosition;
+        if (canMove) MoveEgg(h, input);
+        UpdatePlaying(h);
+    }
+
+    // Sprawdź czy gracz spadł z platformy wygranej
+    if (restrictMovementToWinZone && !finalWinZone.IsPositionInsideZone(eggPosition)) {
+        Crash();
+    }
+
+    CaptureRenderState(currentRenderState);
+}
+
+void World::CaptureRenderState(RenderState& out) const {
+    out.eggPosition = eggPosition;
+    out.platformPositions.resize(platforms.size());
+    for (size_t i = 0; i < platforms.size(); i++) {
+        const MovingPlatform& p = platforms[i];
+        out.platformPositions[i] = glm::mix(p.startPos, p.endPos, p.progress);
+    }
+    out.wallZ.resize(wallCourse.walls.size());
+    for (size_t i = 0; i < wallCourse.walls.size(); i++) out.wallZ[i] = wallCourse.walls[i].zPos;
+}
+
+RenderState World::Interpolate(float alpha) const {
+    const RenderState& a = previousRenderState;
+    const RenderState& b = currentRenderState;
+    RenderState out = b;
+
+    // Teleport (reset, przeniesienie na metę) - bez rozmazywania po całej mapie
+    if (glm::distance(a.eggPosition, b.eggPosition) < 2.0f)
+        out.eggPosition = glm::mix(a.eggPosition, b.eggPosition, alpha);
+
+    if (a.platformPositions.size() == b.platformPositions.size()) {
+        for (size_t i = 0; i < b.platformPositions.size(); i++)
+            out.platformPositions[i] = glm::mix(a.platformPositions[i], b.platformPositions[i], alpha);
+    }
+
+    // Ściana zawinięta na początek drogi - bierzemy nową pozycję
+    if (a.wallZ.size() == b.wallZ.size()) {
+        for (size_t i = 0; i < b.wallZ.size(); i++) {
+            if (std::fabs(a.wallZ[i] - b.wallZ[i]) < 2.0f)
+                out.wallZ[i] = a.wallZ[i] + (b.wallZ[i] - a.wallZ[i]) * alpha;
+        }
+    }
+    return out;
+}
+
+void World::ResetRun() {
+    //og nie usuwac
+    eggPosition = glm::vec3(0.0f, 0.7f, 5.0f);
+    //eggPosition = glm::vec3(-46.0f, 24.3f, 57.0f);
+    //physics.Reset();
+    maxFallHeight = eggPosition.y;
+    crackCount = 0;
+    glassBridge.Reset();
+    finalWinZone.playerHasWon = false;
+    gameWon = false;
+    restrictMovementToWinZone = false;
+    needsReset = false;
+}
+
+void World::Crash() {
+    currentState = GAME_STATE_CRASHED;
+    crashStartTime = time;
+    crackCount = MAX_CRACKS;
+}
+
+// Obrażenia od upadku przy lądowaniu na wysokości landingY (środek jajka)
+void World::ApplyFallDamage(float landingY) {
+    float fall = glm::max(maxFallHeight - landingY, 0.0f);
+    if (fall >= 1.5f) {
+        Crash();
+    }
+    else if (fall >= 0.9f) {
+        crackCount++;
+        if (crackCount >= MAX_CRACKS) {
+            currentState = GAME_STATE_CRASHED;
+            crashStartTime = time;
+        }
+    }
+}
+
+bool World::ProcessInput(const SimInput& input) {
+    if (gameWon && restrictMovementToWinZone) {
+        if (input.start) {
+            gameWon = false;
+            restrictMovementToWinZone = false;
+            needsReset = true;
+            showWinMessage = false;
+            return false;
+        }
+    }
+
+    if (gameWon && currentState == GAME_STATE_MENU) {
+        if (input.start) {
+            gameWon = false;
+            restrictMovementToWinZone = false;
+            needsReset = true;
+            showWinMessage = false;
+            return false;
+        }
+    }
+
+    if (currentState == GAME_STATE_MENU || currentState == GAME_STATE_CRASHED) {
+        if (input.start) {
+            if (!enterKeyPressed) {
+                currentState = GAME_STATE_PLAYING;
+                needsReset = true;
+                showWinMessage = false;
+                enterKeyPressed = true;
+            }
+        }
+        else {
+            enterKeyPressed = false;
+        }
+        return false;
+    }
+    return true;
+}
+
+void World::MoveEgg(float dt, const SimInput& input) {
+    float speed = input.sprint ? 5.0f : 2.5f;
+
+    // Przód "na płasko" i prawo kamery - zależą tylko od yaw
+    float yaw = glm::radians(input.cameraYaw);
+    glm::vec3 f = glm::vec3(std::cos(yaw), 0.0f, std::sin(yaw));
+    glm::vec3 r = glm::vec3(-std::sin(yaw), 0.0f, std::cos(yaw));
+    glm::vec3 lastSafePosition = eggPosition;
+
+    if (physics.isClimbing) {
+        if (input.forward) eggPosition.y += speed * dt;
+        if (input.back) eggPosition.y -= speed * dt;
+
+        // Limit wspinaczki (sufit)
+        eggPosition.y = glm::clamp(eggPosition.y, 0.7f, ladder.position.y + 10.0f);
+
+        if (input.left) eggPosition -= r * speed * dt;
+        if (input.right) eggPosition += r * speed * dt;
+    }
+    else {
+        if (input.forward) eggPosition += f * speed * dt;
+        if (input.back) eggPosition -= f * speed * dt;
+        if (input.left) eggPosition -= r * speed * dt;
+        if (input.right) eggPosition += r * speed * dt;
+    }
+    if (input.jump) physics.TryJump();
+
+    // Ograniczenie ruchu do strefy wygranej
+    if (restrictMovementToWinZone) {
+        if (!finalWinZone.IsPositionInsideZone(eggPosition)) {
+            eggPosition = lastSafePosition;
+        }
+    }
+}
+
+void World::UpdatePlaying(float dt) {
+    // Logika kulek
+    ballManager.Update(dt);
+    if (ballManager.CheckCollision(eggPosition)) {
+        Crash();
+    }
+
+    physics.isClimbing = ladder.CheckCollision(eggPosition);
+
+    colliders.ResolveHorizontal(eggPosition, previousEggPosition, physics.EGG_HALF_HEIGHT);
+
+    maze.checkCollision(eggPosition, previousEggPosition);
+    if (eggPosition.y - 0.7f <= 1.0f &&
+        glm::distance(glm::vec3(eggPosition.x, 0, eggPosition.z), trampoline.position) < trampoline.radius + 1.1f) {
+        eggPosition.x = previousEggPosition.x;
+        eggPosition.z = previousEggPosition.z;
+    }
+
+    if (wallCourse.CheckPlayer(eggPosition, 0.4f)) {
+        crackCount++;
+        if (crackCount >= MAX_CRACKS) {
+            currentState = GAME_STATE_CRASHED;
+            crashStartTime = time;
+        }
+    }
+
+    float oldY = eggPosition.y;
+    physics.ApplyGravity(dt, eggPosition.y);
+    if (!physics.isClimbing && physics.velocityY >= 0.0f) {
+        maxFallHeight = glm::max(eggPosition.y, maxFallHeight);
+    }
+
+    bool standing = physics.isClimbing;
+    if (standing) {
+        maxFallHeight = eggPosition.y;
+        physics.velocityY = 0.0f;
+    }
+
+    for (auto& plat : platforms) {
+        float dist = glm::distance(plat.startPos, plat.endPos);
+        if (dist > 0.001f) {
+            plat.progress += (plat.speed * dt / dist) * plat.direction;
+            if (plat.progress >= 1.0f || plat.progress <= 0.0f) plat.direction *= -1;
+            glm::vec3 curr = glm::mix(plat.startPos, plat.endPos, plat.progress = glm::clamp(plat.progress, 0.0f, 1.0f));
+            plat.currentOffset = curr - glm::mix(plat.startPos, plat.endPos, glm::clamp(plat.progress - (plat.speed * dt * plat.direction / dist), 0.0f, 1.0f));
+            plat.hitbox.minX = curr.x - 1.5f;
+            plat.hitbox.maxX = curr.x + 1.5f;
+            plat.hitbox.minZ = curr.z - 1.5f;
+            plat.hitbox.maxZ = curr.z + 1.5f;
+            plat.hitbox.topY = curr.y;
+            colliders.MoveBox(plat.colliderId, plat.hitbox);
+        }
+    }
+
+    // Blaty, podłogi, rampa, barierki i platformy - jedno zapytanie do siatki
+    if (!standing) {
+        float restY = 0.0f;
+        const Collider* support = colliders.FindSupport(eggPosition, oldY, physics.velocityY,
+            physics.EGG_HALF_HEIGHT, restY);
+        if (support) {
+            if (support->fallDamage) ApplyFallDamage(restY);
+            maxFallHeight = restY;
+            eggPosition.y = restY;
+            physics.velocityY = 0.0f;
+            physics.canJump = true;
+            standing = true;
+            if (support->platform >= 0) eggPosition += platforms[support->platform].currentOffset;
+        }
+    }
+
+    if (!standing && glassBridge.checkCollision(eggPosition, eggPosition.y, physics.velocityY, 0.7f)) {
+        standing = true;
+        physics.canJump = true;
+        maxFallHeight = eggPosition.y;
+    }
+
+    if (!standing && trampoline.checkCollision(eggPosition, eggPosition.y, physics.velocityY, 0.7f)) {
+        physics.canJump = false;
+        maxFallHeight = eggPosition.y;
+    }
+
+    if (!standing && eggPosition.y < 0.7f && oldY >= 0.6f) {
+        ApplyFallDamage(0.7f);
+        maxFallHeight = 0.7f;
+        eggPosition.y = 0.7f;
+        physics.velocityY = 0.0f;
+        physics.canJump = true;
+        standing = true;
+    }
+
+    bool onTiles = windyBridge.CheckCollision(eggPosition, dt);
+    if (onTiles && !standing) {
+        standing = true;
+        physics.canJump = true;
+        maxFallHeight = eggPosition.y;
+    }
+
+    if (windyBridge.IsPlayerFalling(eggPosition)) {
+        Crash();
+    }
+
+    if (eggPosition.z >= (58.0f + (30 - 3) * 2.0f)) {
+        eggPosition = glm::vec3(0.0f, 24.3f + 1.0f, 125.0f);
+    }
+
+    // Wygrana - aktywuj ograniczenie ruchu
+    if (finalWinZone.CheckPlayerInZone(eggPosition) && !gameWon) {
+        gameWon = true;
+        restrictMovementToWinZone = true;
+        showWinMessage = true;
+        winMessage = "=== GRATULACJE! UKONCZYLES PARKOUR! ===";
+        winMessageDisplayTime = time;
+    }
+
+}
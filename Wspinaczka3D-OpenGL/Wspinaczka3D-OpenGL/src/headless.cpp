@@ -0,0 +1,47 @@
+// Symulacja bez okna: uruchamia World::Step w pętli i mierzy kroki na sekundę.
+// Użycie: wspinaczka_headless [liczba_krokow] [dt]
+#include "World.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+// Prosty skrypt sterowania: start gry, bieg do przodu, skoki co jakiś czas
+static SimInput ScriptedInput(const World& world, long step) {
+    SimInput input;
+    if (world.currentState != GAME_STATE_PLAYING) {
+        input.start = (step % 2) == 0; // ENTER musi zostać puszczony między startami
+        return input;
+    }
+    input.forward = true;
+    input.sprint = (step / 300) % 2 == 0;
+    input.jump = (step % 90) < 5;
+    input.cameraYaw = -90.0f + 30.0f * (float)((step / 600) % 3 - 1);
+    return input;
+}
+
+int main(int argc, char** argv) {
+    long steps = argc > 1 ? std::atol(argv[1]) : 1000000;
+    float dt = argc > 2 ? (float)std::atof(argv[2]) : 1.0f / 120.0f;
+    if (steps <= 0 || dt <= 0.0f) {
+        std::cout << "Uzycie: " << argv[0] << " [liczba_krokow] [dt]" << std::endl;
+        return 1;
+    }
+
+    World world;
+    int crashes = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < steps; i++) {
+        GameState before = world.currentState;
+        world.Step(dt, ScriptedInput(world, i));
+        if (before != GAME_STATE_CRASHED && world.currentState == GAME_STATE_CRASHED) crashes++;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Kroki: " << steps << " (dt = " << dt << " s)" << std::endl;
+    std::cout << "Czas: " << seconds << " s, " << (seconds > 0.0 ? steps / seconds : 0.0) << " krokow/s" << std::endl;
+    std::cout << "Czas symulacji: " << world.time << " s, rozbicia: " << crashes << std::endl;
+    std::cout << "Pozycja: " << world.eggPosition.x << ", " << world.eggPosition.y << ", " << world.eggPosition.z << std::endl;
+    return 0;
+}
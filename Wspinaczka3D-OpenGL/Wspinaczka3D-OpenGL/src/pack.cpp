@@ -0,0 +1,71 @@
+// Pakowanie zasobów: wszystkie pliki z podanych katalogów -> jedna paczka (AssetPack) dla gry.
+// Nazwy w paczce to ścieżki względem katalogu roboczego, więc uruchamiać tam, gdzie gra (obok assets/).
+// Pakować po pierwszym uruchomieniu gry i po texconv - wtedy paczka ma też .meshcache i .ktx2.
+// Użycie: wspinaczka_pack [-o assets.pak] katalog...
+#include "AssetPack.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Pliki źródłowe, pozostałości po przerwanym zapisie i puste pliki - gra ich nie czyta
+static bool Skipped(const std::filesystem::path& file) {
+    std::error_code error;
+    if (std::filesystem::file_size(file, error) == 0) return true;
+    std::string extension = file.extension().string();
+    for (char& c : extension) c = (char)std::tolower((unsigned char)c);
+    return extension == ".blend" || extension == ".blend1" || extension == ".tmp";
+}
+
+int main(int argc, char** argv) {
+    std::string output = "assets.pak";
+    std::vector<std::string> directories;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) output = argv[++i];
+        else directories.push_back(argv[i]);
+    }
+    if (directories.empty()) {
+        std::cout << "Uzycie: " << argv[0] << " [-o assets.pak] katalog..." << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::pair<std::string, std::string>> files;
+    for (const std::string& directory : directories) {
+        std::error_code error;
+        for (std::filesystem::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+            if (!it->is_regular_file() || Skipped(it->path())) continue;
+            std::string path = it->path().generic_string();
+            files.push_back({ path, path });
+        }
+        if (error) {
+            std::cout << "ERROR::PACK::CANNOT_READ " << directory << std::endl;
+            return 1;
+        }
+    }
+
+    // Pliki z jednego katalogu obok siebie - model, jego .mtl i tekstury czytane są razem
+    std::sort(files.begin(), files.end());
+    if (!AssetPack::Write(output, files)) return 1;
+
+    // Kontrola: każdy plik da się znaleźć w gotowej paczce
+    AssetPack pack;
+    if (!pack.Open(output)) return 1;
+    uintmax_t bytes = 0;
+    for (const auto& file : files) {
+        size_t size = 0;
+        if (!pack.Find(file.first, size) || size != std::filesystem::file_size(file.second)) {
+            std::cout << "ERROR::PACK::MISSING " << file.first << std::endl;
+            return 1;
+        }
+        bytes += size;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << output << ": " << files.size() << " plikow, " << bytes / 1024 << " KB danych, "
+        << std::filesystem::file_size(output) / 1024 << " KB paczka, " << seconds << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Konwerter tekstur: obraz (png/jpg/bmp...) -> "<plik>.ktx2" z formatem blokowym i wszystkimi mipmapami.
+// Gra (TextureManager) bierze .ktx2 zamiast dekodować obraz, jeśli leży obok pliku źródłowego
+// i powstał z jego obecnej zawartości (hash w pliku) - po edycji obrazu trzeba przekonwertować ponownie.
+// Użycie: wspinaczka_texconv [--format auto|bc1|bc3|bc4|bc5] [--no-flip] plik...
+//   --no-flip  dla ścian skyboxa (cubemapy nie są odwracane w pionie)
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include "TextureCompression.h"
+#include "AssetPath.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Obraz z pliku jako RGBA; 1 kanał -> R, 2 kanały -> RG (tak jak GL_RED / GL_RG w grze)
+static std::vector<unsigned char> ExpandToRGBA(const unsigned char* pixels, int width, int height, int channels) {
+    std::vector<unsigned char> rgba((size_t)width * height * 4);
+    for (size_t i = 0, n = (size_t)width * height; i < n; i++) {
+        const unsigned char* p = pixels + i * channels;
+        unsigned char* q = &rgba[i * 4];
+        q[0] = p[0];
+        q[1] = channels >= 2 ? p[1] : p[0];
+        q[2] = channels >= 3 ? p[2] : p[0];
+        q[3] = channels == 4 ? p[3] : 255;
+    }
+    return rgba;
+}
+
+int main(int argc, char** argv) {
+    std::string formatName = "auto";
+    bool flip = true;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) formatName = argv[++i];
+        else if (std::strcmp(argv[i], "--no-flip") == 0) flip = false;
+        else files.push_back(argv[i]);
+    }
+
+    int forced = -1;
+    for (int f = 0; f < BLOCK_FORMAT_COUNT; f++) {
+        std::string name = TextureCompression::FormatName((BlockFormat)f);
+        for (char& c : name) c = (char)std::tolower((unsigned char)c);
+        if (name == formatName) forced = f;
+    }
+    if (files.empty() || (forced < 0 && formatName != "auto")) {
+        std::cout << "Uzycie: " << argv[0] << " [--format auto|bc1|bc3|bc4|bc5] [--no-flip] plik..." << std::endl;
+        return 1;
+    }
+
+    int failed = 0;
+    stbi_set_flip_vertically_on_load(flip);
+    for (const std::string& file : files) {
+        auto start = std::chrono::steady_clock::now();
+        std::ifstream in(file, std::ios::binary);
+        std::vector<unsigned char> source((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        int width, height, channels;
+        unsigned char* pixels = source.empty() ? nullptr
+            : stbi_load_from_memory(source.data(), (int)source.size(), &width, &height, &channels, 0);
+        if (!pixels) {
+            std::cout << "ERROR::TEXCONV::LOAD_FAILED " << file << std::endl;
+            failed++;
+            continue;
+        }
+        std::vector<unsigned char> rgba = ExpandToRGBA(pixels, width, height, channels);
+        stbi_image_free(pixels);
+
+        BlockFormat format = forced >= 0 ? (BlockFormat)forced
+            : TextureCompression::ChooseFormat(rgba.data(), width, height, channels);
+        CompressedTexture texture = TextureCompression::Compress(rgba.data(), width, height, format, flip);
+        texture.sourceHash = Fnv1a(source.data(), source.size());
+        if (!TextureCompression::WriteKtx2(file + ".ktx2", texture)) {
+            failed++;
+            continue;
+        }
+
+        // Porównanie z tym, co gra wysyłała wcześniej: piksele + mipmapy z glGenerateMipmap
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        size_t raw = (size_t)width * height * (channels == 3 ? 4 : channels) * 4 / 3;
+        std::cout << file << ": " << width << "x" << height << " " << TextureCompression::FormatName(format)
+            << ", " << texture.levels.size() << " poziomow, " << texture.Bytes() / 1024 << " KB (bylo "
+            << raw / 1024 << " KB), " << seconds << " s" << std::endl;
+    }
+    return failed ? 1 : 0;
+}